@@ -0,0 +1,167 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_BITSTREAM_HPP
+#define INTAIRNET_LINKLAYER_GLUE_BITSTREAM_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Writes bit fields most-significant-bit first into a caller-provided byte buffer.
+	 */
+	class BitWriter {
+	public:
+		/**
+		 * @param buffer Byte buffer that is written to.
+		 * @param num_bytes Size of the buffer in bytes.
+		 */
+		BitWriter(uint8_t* buffer, size_t num_bytes) : buffer(buffer), num_bits_available(num_bytes * 8) {}
+
+		/**
+		 * Writes the lowest 'num_bits' bits of 'value'.
+		 * @param value
+		 * @param num_bits At most 64.
+		 * @throws std::out_of_range If the buffer is too small.
+		 */
+		void write(uint64_t value, unsigned int num_bits) {
+			if (num_bits > 64)
+				throw std::invalid_argument("BitWriter::write for more than 64 bits.");
+			if (position + num_bits > num_bits_available)
+				throw std::out_of_range("BitWriter::write exceeds buffer size of " + std::to_string(num_bits_available) + " bits.");
+			while (num_bits > 0) {
+				unsigned int num_free = 8 - (unsigned int) (position % 8);
+				unsigned int n = num_bits < num_free ? num_bits : num_free;
+				unsigned int shift = num_free - n;
+				auto chunk = (uint8_t) ((value >> (num_bits - n)) & ((1u << n) - 1));
+				auto mask = (uint8_t) (((1u << n) - 1) << shift);
+				uint8_t& byte = buffer[position / 8];
+				byte = (uint8_t) ((byte & ~mask) | (chunk << shift));
+				num_bits -= n;
+				position += n;
+			}
+		}
+
+		/** Writes 'num_bits' zero bits, which may be more than 64. */
+		void writeZeros(size_t num_bits) {
+			for (; num_bits > 64; num_bits -= 64)
+				write(0, 64);
+			write(0, (unsigned int) num_bits);
+		}
+
+		void writeBool(bool value) {
+			write(value ? 1 : 0, 1);
+		}
+
+		/** Writes the IEEE-754 representation of 'value'. */
+		void writeDouble(double value) {
+			uint64_t raw;
+			std::memcpy(&raw, &value, sizeof(raw));
+			write(raw, 64);
+		}
+
+		/**
+		 * @return Number of bits written so far.
+		 */
+		size_t getPosition() const {
+			return position;
+		}
+
+	protected:
+		uint8_t* buffer;
+		size_t num_bits_available;
+		size_t position = 0;
+	};
+
+	/**
+	 * Reads bit fields most-significant-bit first from a byte buffer, as written by a BitWriter.
+	 */
+	class BitReader {
+	public:
+		BitReader(const uint8_t* buffer, size_t num_bytes) : buffer(buffer), num_bits_available(num_bytes * 8) {}
+
+		/**
+		 * @param num_bits At most 64.
+		 * @return The next 'num_bits' bits as an unsigned value.
+		 * @throws std::out_of_range If this reads beyond the buffer.
+		 */
+		uint64_t read(unsigned int num_bits) {
+			if (num_bits > 64)
+				throw std::invalid_argument("BitReader::read for more than 64 bits.");
+			if (position + num_bits > num_bits_available)
+				throw std::out_of_range("BitReader::read exceeds buffer size of " + std::to_string(num_bits_available) + " bits.");
+			uint64_t value = 0;
+			while (num_bits > 0) {
+				unsigned int num_left = 8 - (unsigned int) (position % 8);
+				unsigned int n = num_bits < num_left ? num_bits : num_left;
+				unsigned int shift = num_left - n;
+				uint64_t chunk = (buffer[position / 8] >> shift) & ((1u << n) - 1);
+				value = (value << n) | chunk;
+				num_bits -= n;
+				position += n;
+			}
+			return value;
+		}
+
+		/**
+		 * @param num_bits At most 64.
+		 * @return The next 'num_bits' bits interpreted as a two's complement value.
+		 */
+		int64_t readSigned(unsigned int num_bits) {
+			uint64_t value = read(num_bits);
+			if (num_bits < 64 && num_bits > 0 && (value >> (num_bits - 1)) & 1)
+				value |= ~uint64_t(0) << num_bits;
+			return (int64_t) value;
+		}
+
+		bool readBool() {
+			return read(1) == 1;
+		}
+
+		double readDouble() {
+			uint64_t raw = read(64);
+			double value;
+			std::memcpy(&value, &raw, sizeof(value));
+			return value;
+		}
+
+		/** Skips over 'num_bits' bits, which may be more than 64. */
+		void skip(size_t num_bits) {
+			if (position + num_bits > num_bits_available)
+				throw std::out_of_range("BitReader::skip exceeds buffer size of " + std::to_string(num_bits_available) + " bits.");
+			position += num_bits;
+		}
+
+		/**
+		 * @return Number of bits read so far.
+		 */
+		size_t getPosition() const {
+			return position;
+		}
+
+	protected:
+		const uint8_t* buffer;
+		size_t num_bits_available;
+		size_t position = 0;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_BITSTREAM_HPP
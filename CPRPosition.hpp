@@ -55,8 +55,8 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 			return !((*this) == other);
 		}
 
-		double latitude, longitude, altitude;
-		bool odd;
+		double latitude = 0, longitude = 0, altitude = 0;
+		bool odd = false;
 
 		// holds the xyz position from the simulator that is encoded in this
 		SimulatorPosition encodedPosition;
@@ -35,7 +35,8 @@ void DelayMac::onEvent(double time) {
 }
 
 void DelayMac::passToLower(L2Packet* packet, unsigned int center_frequency) {
-	debug("PASSING DOWN");
+	if (isDebugEnabled())
+		debug("PASSING DOWN");
 	IPhy* phy = getLowerLayer();
 	phy->receiveFromUpper(packet, center_frequency);
 }
@@ -54,12 +55,19 @@ void DelayMac::receiveFromLower(L2Packet* packet, uint64_t center_frequency) {
 	arq->receiveFromLower(packet);
 }
 
-void DelayMac::update(uint64_t num_slots) {}
+void DelayMac::receiveSharedFromLower(L2PacketReception reception, uint64_t center_frequency) {
+	IArq* arq = getUpperLayer();
+	arq->receiveSharedFromLower(std::move(reception));
+}
+
+void DelayMac::update(uint64_t num_slots) {
+	IMac::update(num_slots);
+}
 
 
 void DelayMac::execute() {
 
-    if(++counter % 10 != 0 ||  nextPktSize == 0) {
+    if(++counter % 10 != 0 ||  nextPktSize == 0 || is_silent) {
         return;
     }
     auto *packet = new L2Packet();
@@ -72,15 +80,28 @@ void DelayMac::execute() {
 
     packet->addMessage(header, nullptr);
 
-    for (size_t i = 0; i < upper_layer_data->getPayloads().size(); i++) {
+    for (size_t i = 0; i < upper_layer_data->getPayloads().size();) {
         if (upper_layer_data->getHeaders().at(i)->frame_type != L2Header::base) {
-            packet->addMessage(upper_layer_data->getHeaders().at(i)->copy(), upper_layer_data->getPayloads().at(i)->copy());
-        }
+            auto message = upper_layer_data->releaseMessage(i);
+            packet->addMessage(std::move(message.first), std::move(message.second));
+        } else
+            i++;
     }
+    L2Packet::destroy(upper_layer_data);
+    if (!isThereMoreData(nextMacId))
+        nextPktSize = 0;
 
     passToLower(packet, 0);
 }
 
-void DelayMac::onSlotEnd() {
+bool DelayMac::isGoingToTransmitDuringCurrentSlot(uint64_t center_frequency) const {
+	return (counter + 1) % 10 == 0 && nextPktSize != 0 && !is_silent;
+}
+
+void DelayMac::setSilent(bool is_silent) {
+	this->is_silent = is_silent;
+}
 
+void DelayMac::onSlotEnd() {
+	flushEmissions();
 }
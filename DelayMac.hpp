@@ -28,6 +28,7 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		MacId nextMacId;
 
 		int counter = 0;
+		bool is_silent = false;
 	public:
 		explicit DelayMac(const MacId& id);
 
@@ -41,12 +42,20 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 
 		void receiveFromLower(L2Packet* packet, uint64_t center_frequency) override;
 
+		void receiveSharedFromLower(L2PacketReception reception, uint64_t center_frequency) override;
+
 		void onEvent(double time) override;
 
-        void update(uint64_t num_slots);
+		void update(uint64_t num_slots) override;
 
+		/** Transmits the announced data during every tenth call. */
 		void execute();
 
+		bool isGoingToTransmitDuringCurrentSlot(uint64_t center_frequency) const override;
+
+		void setSilent(bool is_silent) override;
+
+		/** Passes the statistics buffered during this slot on to the simulator. */
 		void onSlotEnd();
 	};
 
@@ -0,0 +1,87 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <sstream>
+#include <stdexcept>
+#include "DistributionStatistic.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+DistributionStatistic::DistributionStatistic(const std::string& name, IOmnetPluggable *creator, const std::vector<double>& quantiles, unsigned int emission_interval) : name(name), quantiles(quantiles), emission_interval(emission_interval), creator(creator) {
+	if (emission_interval == 0)
+		throw std::invalid_argument("DistributionStatistic needs a positive emission interval.");
+	for (double quantile : quantiles)
+		if (quantile < 0.0 || quantile > 1.0)
+			throw std::invalid_argument("DistributionStatistic quantiles must be in [0, 1].");
+	if (creator != nullptr) {
+		count_handle = creator->registerSignal(name + "_count");
+		mean_handle = creator->registerSignal(name + "_mean");
+		min_handle = creator->registerSignal(name + "_min");
+		max_handle = creator->registerSignal(name + "_max");
+		for (double quantile : quantiles) {
+			// E.g. 0.5 -> "_p50" and 0.999 -> "_p99.9".
+			std::ostringstream signal_name;
+			signal_name << name << "_p" << quantile * 100.0;
+			quantile_handles.push_back(creator->registerSignal(signal_name.str()));
+		}
+	}
+}
+
+void DistributionStatistic::capture(double sample) {
+	// record() throws for invalid samples, so it goes first to leave the summary untouched.
+	record(sample);
+	if (count == 0 || sample < min)
+		min = sample;
+	if (count == 0 || sample > max)
+		max = sample;
+	count++;
+	sum += sample;
+	was_updated = true;
+}
+
+void DistributionStatistic::update() {
+	num_updates_since_emission++;
+	if (was_updated && num_updates_since_emission >= emission_interval) {
+		creator->emit(count_handle, (double) count);
+		creator->emit(mean_handle, getMean());
+		creator->emit(min_handle, min);
+		creator->emit(max_handle, max);
+		for (size_t i = 0; i < quantiles.size(); i++)
+			creator->emit(quantile_handles.at(i), getQuantile(quantiles.at(i)));
+		was_updated = false;
+		num_updates_since_emission = 0;
+	}
+}
+
+uint64_t DistributionStatistic::getCount() const {
+	return count;
+}
+
+double DistributionStatistic::getMean() const {
+	return count == 0 ? 0.0 : sum / count;
+}
+
+double DistributionStatistic::getMin() const {
+	return min;
+}
+
+double DistributionStatistic::getMax() const {
+	return max;
+}
+
+bool DistributionStatistic::wasUpdated() const {
+	return was_updated;
+}
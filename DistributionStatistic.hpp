@@ -0,0 +1,86 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef TUHH_INTAIRNET_MC_SOTDMA_DISTRIBUTIONSTATISTIC_HPP
+#define TUHH_INTAIRNET_MC_SOTDMA_DISTRIBUTIONSTATISTIC_HPP
+
+#include <string>
+#include <vector>
+#include "IOmnetPluggable.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Aggregates samples of a per-event metric, such as a link establishment time, in constant memory.
+	 * Instead of every sample, update() emits a summary: '<name>_count', '<name>_mean', '<name>_min', '<name>_max' and one '<name>_p<percent>' per configured quantile, e.g. '<name>_p99'.
+	 * Subclasses define how quantiles are estimated.
+	 */
+	class DistributionStatistic {
+	public:
+		/**
+		 * @param name
+		 * @param creator
+		 * @param quantiles Quantiles in [0, 1] to emit.
+		 * @param emission_interval Emit at most once every this many update() calls.
+		 * @throws std::invalid_argument For quantiles outside [0, 1] or a zero interval.
+		 */
+		DistributionStatistic(const std::string& name, IOmnetPluggable *creator, const std::vector<double>& quantiles, unsigned int emission_interval);
+
+		virtual ~DistributionStatistic() = default;
+
+		/**
+		 * Capture a new sample.
+		 * @throws std::invalid_argument If the subclass rejects the sample, in which case nothing changes.
+		 */
+		void capture(double sample);
+
+		/** Called after every slot. Emits the summary if new samples have been captured and the emission interval has passed. */
+		void update();
+
+		/**
+		 * @param quantile In [0, 1].
+		 * @return Estimate of the quantile over all samples captured so far, or 0 if there are none.
+		 */
+		virtual double getQuantile(double quantile) const = 0;
+
+		uint64_t getCount() const;
+		double getMean() const;
+		double getMin() const;
+		double getMax() const;
+
+		bool wasUpdated() const;
+
+	protected:
+		/**
+		 * Add a sample to the quantile estimate. Called before the count, sum, min and max are updated.
+		 * @throws std::invalid_argument For samples the estimate can't hold. Must not change any state then.
+		 */
+		virtual void record(double sample) = 0;
+
+		const std::string name;
+		const std::vector<double> quantiles;
+		const unsigned int emission_interval;
+		IOmnetPluggable *creator = nullptr;
+		IOmnetPluggable::SignalHandle count_handle = 0, mean_handle = 0, min_handle = 0, max_handle = 0;
+		std::vector<IOmnetPluggable::SignalHandle> quantile_handles;
+		uint64_t count = 0;
+		double sum = 0.0, min = 0.0, max = 0.0;
+		bool was_updated = false;
+		unsigned int num_updates_since_emission = 0;
+	};
+}
+
+#endif //TUHH_INTAIRNET_MC_SOTDMA_DISTRIBUTIONSTATISTIC_HPP
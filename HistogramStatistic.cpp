@@ -0,0 +1,103 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "HistogramStatistic.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	/** @return Number of bits needed to represent 'value'. */
+	unsigned int bitLength(uint64_t value) {
+		unsigned int length = 0;
+		for (; value != 0; value >>= 1)
+			length++;
+		return length;
+	}
+}
+
+HistogramStatistic::HistogramStatistic(const std::string& name, IOmnetPluggable *creator, double highest_trackable_value, unsigned int significant_digits, double resolution, const std::vector<double>& quantiles, unsigned int emission_interval)
+	: DistributionStatistic(name, creator, quantiles, emission_interval), resolution(resolution) {
+	if (significant_digits < 1 || significant_digits > 5)
+		throw std::invalid_argument("HistogramStatistic supports 1 to 5 significant digits.");
+	if (resolution <= 0.0 || highest_trackable_value < 2.0 * resolution || highest_trackable_value / resolution > 1e18)
+		throw std::invalid_argument("HistogramStatistic needs a positive resolution and a highest trackable value of at least twice the resolution.");
+	this->highest_trackable_value = (uint64_t) std::llround(highest_trackable_value / resolution);
+	// Sub-buckets must distinguish 2*10^digits values for the requested precision.
+	const uint64_t largest_value_with_single_unit_resolution = 2 * (uint64_t) std::pow(10, significant_digits);
+	sub_bucket_half_count_magnitude = bitLength(largest_value_with_single_unit_resolution - 1) - 1;
+	const uint64_t sub_bucket_count = uint64_t(1) << (sub_bucket_half_count_magnitude + 1);
+	sub_bucket_half_count = sub_bucket_count / 2;
+	sub_bucket_mask = sub_bucket_count - 1;
+	// Each further bucket covers twice the range of the previous one.
+	size_t bucket_count = 1;
+	for (uint64_t smallest_untrackable_value = sub_bucket_count; smallest_untrackable_value <= this->highest_trackable_value; smallest_untrackable_value <<= 1)
+		bucket_count++;
+	counts = std::vector<uint64_t>((bucket_count + 1) * sub_bucket_half_count, 0);
+}
+
+void HistogramStatistic::record(double sample) {
+	if (!(sample >= 0.0))
+		throw std::invalid_argument("HistogramStatistic::record for negative or NaN sample " + std::to_string(sample) + ".");
+	uint64_t value = (uint64_t) std::llround(sample / resolution);
+	if (value > highest_trackable_value) {
+		value = highest_trackable_value;
+		num_saturated++;
+	}
+	counts.at(getIndex(value))++;
+}
+
+double HistogramStatistic::getQuantile(double quantile) const {
+	if (count == 0)
+		return 0.0;
+	if (quantile <= 0.0)
+		return min;
+	const uint64_t rank = std::max(uint64_t(1), (uint64_t) std::ceil(quantile * count));
+	uint64_t num_seen = 0;
+	for (size_t index = 0; index < counts.size(); index++) {
+		num_seen += counts[index];
+		if (num_seen >= rank)
+			return std::min(max, std::max(min, getHighestEquivalentValue(index) * resolution));
+	}
+	return max;
+}
+
+uint64_t HistogramStatistic::getNumSaturated() const {
+	return num_saturated;
+}
+
+size_t HistogramStatistic::getNumCounts() const {
+	return counts.size();
+}
+
+size_t HistogramStatistic::getIndex(uint64_t value) const {
+	const unsigned int bucket_index = bitLength(value | sub_bucket_mask) - (sub_bucket_half_count_magnitude + 1);
+	const uint64_t sub_bucket_index = value >> bucket_index;
+	return ((size_t(bucket_index) + 1) << sub_bucket_half_count_magnitude) + (sub_bucket_index - sub_bucket_half_count);
+}
+
+uint64_t HistogramStatistic::getHighestEquivalentValue(size_t index) const {
+	int bucket_index = int(index >> sub_bucket_half_count_magnitude) - 1;
+	uint64_t sub_bucket_index = (index & (sub_bucket_half_count - 1)) + sub_bucket_half_count;
+	if (bucket_index < 0) {
+		sub_bucket_index -= sub_bucket_half_count;
+		bucket_index = 0;
+	}
+	const uint64_t lowest_equivalent_value = sub_bucket_index << bucket_index;
+	return lowest_equivalent_value + (uint64_t(1) << bucket_index) - 1;
+}
@@ -0,0 +1,68 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef TUHH_INTAIRNET_MC_SOTDMA_HISTOGRAMSTATISTIC_HPP
+#define TUHH_INTAIRNET_MC_SOTDMA_HISTOGRAMSTATISTIC_HPP
+
+#include "DistributionStatistic.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Records samples in a high dynamic range (HDR) histogram: buckets grow exponentially, and each is split into linear sub-buckets,
+	 * so that every sample up to 'highest_trackable_value' is kept to a fixed number of significant decimal digits.
+	 * Memory is allocated once on construction and depends only on the value range and precision.
+	 */
+	class HistogramStatistic : public DistributionStatistic {
+	public:
+		/**
+		 * @param name
+		 * @param creator
+		 * @param highest_trackable_value Larger samples are counted as this value.
+		 * @param significant_digits Precision in [1, 5].
+		 * @param resolution Smallest distinguishable difference between samples, e.g. 1 for values in slots.
+		 * @param quantiles
+		 * @param emission_interval
+		 * @throws std::invalid_argument For invalid parameters.
+		 */
+		HistogramStatistic(const std::string& name, IOmnetPluggable *creator, double highest_trackable_value, unsigned int significant_digits = 2, double resolution = 1.0, const std::vector<double>& quantiles = {0.5, 0.9, 0.99}, unsigned int emission_interval = 1);
+
+		double getQuantile(double quantile) const override;
+
+		/** @return Number of samples larger than the highest trackable value. */
+		uint64_t getNumSaturated() const;
+
+		/** @return Number of histogram buckets. */
+		size_t getNumCounts() const;
+
+	protected:
+		/** @throws std::invalid_argument For negative or NaN samples. */
+		void record(double sample) override;
+
+		size_t getIndex(uint64_t value) const;
+		/** @return Largest value that maps to the same index. */
+		uint64_t getHighestEquivalentValue(size_t index) const;
+
+		const double resolution;
+		uint64_t highest_trackable_value;
+		unsigned int sub_bucket_half_count_magnitude;
+		uint64_t sub_bucket_half_count, sub_bucket_mask;
+		std::vector<uint64_t> counts;
+		uint64_t num_saturated = 0;
+	};
+}
+
+#endif //TUHH_INTAIRNET_MC_SOTDMA_HISTOGRAMSTATISTIC_HPP
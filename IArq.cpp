@@ -34,6 +34,10 @@ void IArq::receiveFromLower(L2Packet* packet) {
 	this->upper_layer->receiveFromLower(packet);
 }
 
+void IArq::receiveSharedFromLower(L2PacketReception reception) {
+	receiveFromLower(reception.release());
+}
+
 unsigned int IArq::getNumHopsToGS() const {
 	assert(this->upper_layer && "IArq::getNumHopsToGS called but upper layer is unset.");
 	return upper_layer->getNumHopsToGS();
@@ -18,6 +18,8 @@
 #define INTAIRNET_LINKLAYER_GLUE_IARQ_HPP
 
 #include "L2Packet.hpp"
+#include "L2PacketReception.hpp"
+#include "L2HeaderVisitor.hpp"
 
 namespace TUHH_INTAIRNET_MCSOTDMA {
 
@@ -104,6 +106,13 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 */
 		virtual void receiveFromLower(L2Packet* packet);
 
+		/**
+		 * When a packet that other receivers share arrives via PHY and MAC.
+		 * By default, the released packet is passed to receiveFromLower(L2Packet*), which is only copied if other receivers still share it. Override this to read the packet without copying it.
+		 * @param reception Move it on to hold on to the packet beyond this call.
+		 */
+		virtual void receiveSharedFromLower(L2PacketReception reception);
+
 		/**
 		 * Interface to inform ARQ about a missed packet from src
 		 * @param src
@@ -155,10 +164,23 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 	protected:
 		/**
 		 * When a packet comes in via PHY and MAC, this function parses its header and updates the internal ARQ state.
+		 * Implementations can go through visitHeaders() to handle each header type without virtual calls or casts.
 		 * @param incoming_packet
 		 */
 		virtual void processIncomingHeader(L2Packet* incoming_packet) = 0;
 
+		/**
+		 * Calls 'visitor' with every header of 'packet' cast to its concrete type, see visit(). Messages without a header are skipped.
+		 * @param packet
+		 * @param visitor
+		 */
+		template <typename Visitor>
+		static void visitHeaders(L2Packet* packet, Visitor&& visitor) {
+			for (L2Header* header : packet->getHeaders())
+				if (header != nullptr)
+					visit(*header, visitor);
+		}
+
 		IRlc* upper_layer = nullptr;
 		IMac* lower_layer = nullptr;
 		/** Maximum number of retransmission attempts (not including the initial try). */
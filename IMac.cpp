@@ -14,14 +14,17 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <cassert>
 #include "IMac.hpp"
 #include "IArq.hpp"
 #include "IPhy.hpp"
+#include "IRlc.hpp"
+#include "IOmnetPluggable.hpp"
 
 using namespace TUHH_INTAIRNET_MCSOTDMA;
 
-IMac::IMac(const MacId& id) : id(id), position_map(), position_quality_map() {
+IMac::IMac(const MacId& id) : id(id), neighbor_positions(), neighbor_grid() {
 	updatePosition(id, CPRPosition(), CPRPosition::PositionQuality::hi);
 }
 
@@ -56,24 +59,78 @@ void IMac::reportNumHopsToGS(const MacId& id, unsigned int num_hops) const {
 }
 
 const CPRPosition& IMac::getPosition(const MacId& id) const {
-	try {
-		return position_map.at(id);
-	} catch (const std::out_of_range& e) {
-		throw std::out_of_range("MCSOTDMA_Mac::getPosition for unknown ID: " + std::string(e.what()));
-	}
+	const NeighborPositionTable::Entry* entry = neighbor_positions.find(id);
+	if (entry == nullptr)
+		throw std::out_of_range("MCSOTDMA_Mac::getPosition for unknown ID: " + std::to_string(id.getId()));
+	return entry->position;
+}
+
+const CPRPosition* IMac::findPosition(const MacId& id) const {
+	const NeighborPositionTable::Entry* entry = neighbor_positions.find(id);
+	return entry == nullptr ? nullptr : &entry->position;
 }
 
 void IMac::updatePosition(const MacId& id, const CPRPosition& position, CPRPosition::PositionQuality pos_quality) {
-	position_map[id] = position;
-	position_quality_map[id] = pos_quality;
+	neighbor_positions.update(id, position, pos_quality);
+	neighbor_grid.update(id, position.encodedPosition);
 }
 
 CPRPosition::PositionQuality IMac::getPositionQuality(const MacId& id) const {
-	try {
-		return position_quality_map.at(id);
-	} catch (const std::out_of_range& e) {
-		throw std::out_of_range("MCSOTDMA_Mac::getPositionQuality for unknown ID: " + std::string(e.what()));
+	const NeighborPositionTable::Entry* entry = neighbor_positions.find(id);
+	if (entry == nullptr)
+		throw std::out_of_range("MCSOTDMA_Mac::getPositionQuality for unknown ID: " + std::to_string(id.getId()));
+	return entry->quality;
+}
+
+const NeighborPositionTable& IMac::getNeighborPositions() const {
+	return neighbor_positions;
+}
+
+std::vector<MacId> IMac::getNeighborsWithin(double radius) const {
+	const SimulatorPosition& own_position = getPosition(id).encodedPosition;
+	std::vector<MacId> neighbors;
+	if (neighbor_positions.size() <= max_num_linear_scan_neighbors) {
+		if (radius < 0.0)
+			return neighbors;
+		const double squared_radius = radius * radius;
+		for (const auto& entry : neighbor_positions)
+			if (entry.id != id.getId() && SpatialGrid::getSquaredDistance(entry.position.encodedPosition, own_position) <= squared_radius)
+				neighbors.emplace_back(entry.id);
+		return neighbors;
 	}
+	neighbors = neighbor_grid.neighborsWithin(own_position, radius);
+	neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), id), neighbors.end());
+	return neighbors;
+}
+
+std::vector<MacId> IMac::getNearestNeighbors(size_t k) const {
+	const SimulatorPosition& own_position = getPosition(id).encodedPosition;
+	if (neighbor_positions.size() <= max_num_linear_scan_neighbors) {
+		std::vector<std::pair<double, int>> candidates;
+		candidates.reserve(neighbor_positions.size());
+		for (const auto& entry : neighbor_positions)
+			if (entry.id != id.getId())
+				candidates.emplace_back(SpatialGrid::getSquaredDistance(entry.position.encodedPosition, own_position), entry.id);
+		const size_t num_nearest = std::min(k, candidates.size());
+		std::partial_sort(candidates.begin(), candidates.begin() + num_nearest, candidates.end());
+		std::vector<MacId> neighbors;
+		neighbors.reserve(num_nearest);
+		for (size_t i = 0; i < num_nearest; i++)
+			neighbors.emplace_back(candidates[i].second);
+		return neighbors;
+	}
+	// This user is closest to itself, so query one more.
+	std::vector<MacId> neighbors = neighbor_grid.nearest(own_position, k + 1);
+	auto self = std::find(neighbors.begin(), neighbors.end(), id);
+	if (self != neighbors.end())
+		neighbors.erase(self);
+	else if (neighbors.size() > k)
+		neighbors.pop_back();
+	return neighbors;
+}
+
+const SpatialGrid& IMac::getNeighborGrid() const {
+	return neighbor_grid;
 }
 
 bool IMac::isTransmitterIdle(unsigned int slot_offset, unsigned int num_slots) const {
@@ -86,10 +143,33 @@ bool IMac::isAnyReceiverIdle(unsigned int slot_offset, unsigned int num_slots) c
 	return lower_layer->isAnyReceiverIdle(slot_offset, num_slots);
 }
 
+void IMac::receiveSharedFromLower(L2PacketReception reception, uint64_t center_frequency) {
+	receiveFromLower(reception.release(), center_frequency);
+}
+
 void IMac::update(uint64_t num_slots) {
+	flushStackEmissions();
 	current_slot += num_slots;
 }
 
+void IMac::flushStackEmissions() {
+	// Spares every MAC touching its layers while nothing is buffered anywhere.
+	if (!IOmnetPluggable::isAnyEmissionPending())
+		return;
+	IRlc* rlc = upper_layer == nullptr ? nullptr : upper_layer->getUpperLayer();
+	if (emission_targets.mac != this || emission_targets.arq != upper_layer || emission_targets.rlc != rlc) {
+		emission_targets.mac = this;
+		emission_targets.arq = upper_layer;
+		emission_targets.rlc = rlc;
+		emission_targets.pluggables[0] = dynamic_cast<IOmnetPluggable*>(this);
+		emission_targets.pluggables[1] = dynamic_cast<IOmnetPluggable*>(upper_layer);
+		emission_targets.pluggables[2] = dynamic_cast<IOmnetPluggable*>(rlc);
+	}
+	for (IOmnetPluggable* pluggable : emission_targets.pluggables)
+		if (pluggable != nullptr)
+			pluggable->flushEmissions();
+}
+
 uint64_t IMac::getCurrentSlot() const {
 	return current_slot;
 }
@@ -191,6 +271,29 @@ void IMac::reportMissingPpPacket(const MacId &id) {
 	upper_layer->notifyAboutMissedPacket(id);
 }
 
-void IMac::shouldCapturePerSlotStatistics(bool flag) {
+void IMac::shouldCapturePerSlotStatistics(bool flag, size_t buffer_capacity) {
 	this->capture_per_slot_statistics = flag;
-}
\ No newline at end of file
+	if (flag)
+		per_slot_statistics.allocate(buffer_capacity);
+}
+
+void IMac::capturePerSlotStatistic(uint32_t kind, double value) {
+	PerSlotStatisticsRing* ring = per_slot_statistics.getRing();
+	// A copied MAC keeps the flag, but not the buffer.
+	if (capture_per_slot_statistics && ring != nullptr)
+		ring->tryPush(PerSlotRecord(current_slot, id.getId(), kind, value));
+}
+
+void IMac::writePerSlotStatisticsTo(const std::string& filename) {
+	if (per_slot_statistics.getRing() == nullptr)
+		throw std::runtime_error("IMac::writePerSlotStatisticsTo called but per-slot statistics are not captured.");
+	per_slot_statistics.startWriter(filename);
+}
+
+void IMac::stopWritingPerSlotStatistics() {
+	per_slot_statistics.stopWriter();
+}
+
+PerSlotStatisticsRing* IMac::getPerSlotStatistics() {
+	return per_slot_statistics.getRing();
+}
@@ -19,17 +19,24 @@
 
 #include "MacId.hpp"
 #include "L2Packet.hpp"
+#include "L2PacketReception.hpp"
 #include "L2Header.hpp"
 #include "Timestamp.hpp"
 #include "ContentionMethod.hpp"
 #include "DutyCycleBudgetStrategy.hpp"
+#include "NeighborPositionTable.hpp"
+#include "SpatialGrid.hpp"
+#include "PerSlotStatistics.hpp"
 #include <map>
 #include <functional>
 
+class IOmnetPluggable;
+
 namespace TUHH_INTAIRNET_MCSOTDMA {
 
 	class IArq; // Forward-declaration so that we can keep a pointer to the ARQ sublayer.
 	class IPhy; // Forward-declaration so that we can keep a pointer to the PHY layer.
+	class IRlc;
 
 	/**
 	 * Specifies the interface the MAC sublayer must implement.
@@ -74,6 +81,14 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 */
 		virtual void receiveFromLower(L2Packet* packet, uint64_t center_frequency) = 0;
 
+		/**
+		 * Define what happens when the PHY passes a just-received packet that other receivers share.
+		 * By default, the released packet is passed to receiveFromLower(L2Packet*, uint64_t), which is only copied if other receivers still share it. Override this to read the packet without copying it.
+		 * @param reception Move it on to hold on to the packet beyond this call.
+		 * @param center_frequency
+		 */
+		virtual void receiveSharedFromLower(L2PacketReception reception, uint64_t center_frequency);
+
 		/**
 		 * When a packet comes in, this passes it up to the next upper layer.
 		 * @param packet
@@ -144,12 +159,44 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 
 		/**
 		 * @param id
-		 * @return The current belief ot the respective user's geographic position.
+		 * @return The current belief ot the respective user's geographic position. The reference is valid until the next updatePosition() call.
+		 * @throws std::out_of_range If the user's position is unknown.
 		 */
 		const CPRPosition& getPosition(const MacId& id) const;
 
+		/**
+		 * @param id
+		 * @return The current belief of the respective user's geographic position, or nullptr if it is unknown. The pointer is valid until the next updatePosition() call.
+		 */
+		const CPRPosition* findPosition(const MacId& id) const;
+
+		/**
+		 * @throws std::out_of_range If the user's position is unknown.
+		 */
 		CPRPosition::PositionQuality getPositionQuality(const MacId& id) const;
 
+		/**
+		 * @return Positions and position qualities of all known users, including this one.
+		 */
+		const NeighborPositionTable& getNeighborPositions() const;
+
+		/**
+		 * @param radius
+		 * @return All other users whose position (CPRPosition::encodedPosition) lies within 'radius' of this user's position, in no particular order.
+		 */
+		std::vector<MacId> getNeighborsWithin(double radius) const;
+
+		/**
+		 * @param k
+		 * @return The (up to) k other users closest to this user's position, closest first.
+		 */
+		std::vector<MacId> getNearestNeighbors(size_t k) const;
+
+		/**
+		 * @return Spatial index over the positions of all known users, including this one, for queries around arbitrary positions.
+		 */
+		const SpatialGrid& getNeighborGrid() const;
+
 		/**
 		 * Update the belief of the respective user's geographic position.
 		 * @param id
@@ -167,7 +214,7 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 
 		virtual bool isGoingToTransmitDuringCurrentSlot(uint64_t center_frequency) const = 0;
 
-		/** Increment time. Updates the linked PHY. */
+		/** Increment time. Updates the linked PHY. Also passes on the statistics that this MAC and the ARQ and RLC above it buffered during the past slot, see IOmnetPluggable::flushEmissions(). */
 		virtual void update(uint64_t num_slots);
 
 		uint64_t getCurrentSlot() const;
@@ -253,23 +300,64 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		virtual void setSilent(bool is_silent) = 0;
 
 		/** Set whether to capture per-slot statistics. 
-		 * These can take up a lot of memory. 
-		 * So enable these only if explicitly required by your evaluation.
+		 * Records are kept in a preallocated ring buffer of 'buffer_capacity' records, which is allocated when capturing is first enabled.
+		 * Memory use is therefore constant, but records are dropped if nobody drains the buffer, e.g. through writePerSlotStatisticsTo().
+		 * @param flag
+		 * @param buffer_capacity Number of records the buffer can hold; ignored if the buffer already exists.
 		*/
-		void shouldCapturePerSlotStatistics(bool flag);
+		void shouldCapturePerSlotStatistics(bool flag, size_t buffer_capacity = 65536);
+
+		/**
+		 * Records a per-slot statistic for the current slot. Never blocks; does nothing unless per-slot statistics are captured into this MAC's own buffer.
+		 * @param kind User-defined identifier of the statistic.
+		 * @param value
+		 */
+		void capturePerSlotStatistic(uint32_t kind, double value);
+
+		/**
+		 * Starts a background thread that continuously drains captured per-slot statistics into a binary file of PerSlotRecord structs.
+		 * @param filename
+		 * @throws std::runtime_error If per-slot statistics are not captured or the file cannot be opened.
+		 */
+		void writePerSlotStatisticsTo(const std::string& filename);
+
+		/** Writes all remaining per-slot statistics and stops the background thread, if any. */
+		void stopWritingPerSlotStatistics();
+
+		/** @return The per-slot statistics buffer, or nullptr if capturing has never been enabled. */
+		PerSlotStatisticsRing* getPerSlotStatistics();
 
 
 	protected:
 		IArq* upper_layer = nullptr;
 		IPhy* lower_layer = nullptr;
 		MacId id;
-		std::map<MacId, CPRPosition> position_map;
-		std::map<MacId, CPRPosition::PositionQuality> position_quality_map;
+		/** Position and position quality of every known user. */
+		NeighborPositionTable neighbor_positions;
+		/** Spatial index over 'neighbor_positions', maintained by updatePosition(). */
+		SpatialGrid neighbor_grid;
+		/** Up to this many known users, scanning 'neighbor_positions' answers neighbor queries faster than 'neighbor_grid'. */
+		static constexpr size_t max_num_linear_scan_neighbors = 64;
 		uint64_t current_slot = 0;
 		std::function<void (MacId origin_id, CPRPosition position)> passUpBeaconFct = [] (MacId origin_id, CPRPosition position) {/* do nothing */};
 		bool should_force_bidirectional_links = true;
-		/** Per-slot statistics can take up a lot of memory. So enable these only if explicitly required by your evaluation. */
+		/** Per-slot statistics go into a bounded ring buffer, which is allocated only once they are enabled. Copies of this MAC start without a buffer and capture nothing. */
 		bool capture_per_slot_statistics = false;
+		PerSlotStatisticsCapture per_slot_statistics;
+
+		/** Flushes the emissions of this MAC and the ARQ and RLC above it, see update(). */
+		void flushStackEmissions();
+
+		/**
+		 * The layers that flushStackEmissions() flushes, or nullptr for those that aren't IOmnetPluggables.
+		 * Cross-casting every slot is costly, so they are only resolved again when the MAC is copied or the stack above it changes.
+		 */
+		struct EmissionTargets {
+			const IMac* mac = nullptr;
+			const IArq* arq = nullptr;
+			const IRlc* rlc = nullptr;
+			IOmnetPluggable* pluggables[3] = {nullptr, nullptr, nullptr};
+		} emission_targets;
 	};
 }
 
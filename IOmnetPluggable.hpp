@@ -17,14 +17,59 @@
 #ifndef INTAIRNET_LINKLAYER_GLUE_IOMNETPLUGGABLE_HPP
 #define INTAIRNET_LINKLAYER_GLUE_IOMNETPLUGGABLE_HPP
 
+#include <atomic>
 #include <functional>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "L2Packet.hpp"
 #include "L3Packet.hpp"
+#include "IOmnetSink.hpp"
 
+/**
+ * Connects a glue component to the simulator.
+ * Either set an IOmnetSink, which makes every call a single virtual call,
+ * or register the individual std::function callbacks, which remain supported for compatibility and are used while no sink is set.
+ */
 class IOmnetPluggable {
 public:
+	/** Passes on values that are still buffered, see flushEmissions(). */
+	virtual ~IOmnetPluggable() {
+		flushEmissions();
+	}
+
+	/** Integer handle of a signal name, valid for the IOmnetPluggable that issued it. */
+	typedef IOmnetSink::SignalHandle SignalHandle;
+
+	/** A single value emitted through a batch. */
+	struct SignalEmission {
+		SignalEmission(SignalHandle handle, double value) : handle(handle), value(value) {}
+
+		SignalHandle handle;
+		double value;
+	};
+
+	/**
+	 * Routes all calls to 'sink' instead of the std::function callbacks. Signals registered so far are reported to the sink.
+	 * @param sink Must outlive this instance; nullptr to go back to the callbacks.
+	 */
+	void setSink(IOmnetSink* sink) {
+		this->sink = sink;
+		if (sink != nullptr) {
+			flushEmissions();
+			for (SignalHandle handle = 0; handle < (SignalHandle) signal_names.size(); handle++)
+				sink->onSignalRegistered(handle, signal_names[handle]);
+		}
+	}
+
+	IOmnetSink* getSink() const {
+		return sink;
+	}
+
 	double getTime() {
+		if (sink)
+			return sink->getTime();
 		if (getTimeCallback) {
 			return getTimeCallback();
 		}
@@ -32,46 +77,152 @@ public:
 	}
 
 	void scheduleAt(double time) {
-		if (scheduleAtCallback) {
+		if (sink)
+			sink->scheduleAt(time);
+		else if (scheduleAtCallback) {
 			scheduleAtCallback(time);
 		}
 	}
 
 	void emit(const std::string& event_name, double value) {
-		if (emitCallback) {
+		if (sink || emitBatchCallback) {
+			emit(registerSignal(event_name), value);
+		} else if (emitCallback) {
 			emitCallback(event_name, value);
 		}
 	}
 
+	/**
+	 * Interns a signal name. Registering the same name again returns the same handle.
+	 * @param event_name
+	 * @return Handle to pass to emit(SignalHandle, double).
+	 */
+	SignalHandle registerSignal(const std::string& event_name) {
+		auto it = signal_handles.find(event_name);
+		if (it != signal_handles.end())
+			return it->second;
+		const SignalHandle handle = (SignalHandle) signal_names.size();
+		signal_names.push_back(event_name);
+		signal_handles.emplace(event_name, handle);
+		if (sink)
+			sink->onSignalRegistered(handle, event_name);
+		return handle;
+	}
+
+	/**
+	 * @param handle
+	 * @return The name the handle was registered for.
+	 * @throws std::out_of_range For unknown handles.
+	 */
+	const std::string& getSignalName(SignalHandle handle) const {
+		return signal_names.at(handle);
+	}
+
+	/**
+	 * With a sink, the value is passed to it right away.
+	 * Otherwise, if a batch callback is registered, the value is buffered until flushEmissions() or until getMaxPendingEmissions() values are pending, and else it is passed to the per-value emit callback.
+	 * @param handle From registerSignal().
+	 * @param value
+	 */
+	void emit(SignalHandle handle, double value) {
+		if (sink) {
+			sink->emit(handle, value);
+		} else if (emitBatchCallback) {
+			pending_emissions.push(handle, value);
+			if (pending_emissions.size() >= max_pending_emissions)
+				flushEmissions();
+		} else if (emitCallback) {
+			emitCallback(signal_names.at(handle), value);
+		}
+	}
+
+	/**
+	 * Passes all buffered values to the batch callback in a single call. Nothing is buffered while a sink is set.
+	 * A batch carries no timestamp, so this must happen in the slot the values belong to:
+	 * IMac::update() flushes the MAC, ARQ and RLC of a stack at every slot boundary, DelayMac::onSlotEnd() at the end of a slot,
+	 * and the pass-through ARQ and RLC after each of their events. Values still pending on destruction are flushed, too.
+	 * emit() flushes a full buffer in between, see setMaxPendingEmissions().
+	 */
+	void flushEmissions() {
+		if (!pending_emissions.empty()) {
+			if (emitBatchCallback)
+				emitBatchCallback(pending_emissions.data(), pending_emissions.size());
+			pending_emissions.clear();
+		}
+	}
+
+	/**
+	 * @param max_pending_emissions Number of buffered values at which emit() flushes on its own.
+	 * @throws std::invalid_argument If zero.
+	 */
+	/** @return Whether any IOmnetPluggable holds buffered values, s.t. per-slot hooks can skip flushing without touching the components. */
+	static bool isAnyEmissionPending() {
+		return PendingEmissions::isAnyNonEmpty();
+	}
+
+	void setMaxPendingEmissions(size_t max_pending_emissions) {
+		if (max_pending_emissions == 0)
+			throw std::invalid_argument("IOmnetPluggable::setMaxPendingEmissions needs a positive limit.");
+		this->max_pending_emissions = max_pending_emissions;
+		if (pending_emissions.size() >= max_pending_emissions)
+			flushEmissions();
+	}
+
+	size_t getMaxPendingEmissions() const {
+		return max_pending_emissions;
+	}
+
 	void emit(const std::string& event_name, size_t value) {
 		this->emit(event_name, (double) value);
 	}
 
+	/** @return Whether debug() does anything, so that callers can skip building messages. */
+	bool isDebugEnabled() const {
+		if (sink)
+			return sink->isDebugEnabled();
+		return (bool) debugCallback;
+	}
+
 	void debug(const std::string& message) {
-		if (debugCallback) {
+		if (sink)
+			sink->debug(message);
+		else if (debugCallback) {
 			debugCallback(message);
 		}
 	}
 
+	/** Packets and payloads that belong to a SlotArena are left to it and never handed to the simulator. */
 	void deletePacket(TUHH_INTAIRNET_MCSOTDMA::L2Packet* packet) {
-        if (deleteL2Callback) {
+        if (packet != nullptr && packet->getArena() != nullptr)
+            return;
+        if (sink)
+            sink->deletePacket(packet);
+        else if (deleteL2Callback) {
             deleteL2Callback(packet);
         }
 	}
 
     void deletePacket(L3Packet* packet) {
-        if (deleteL3Callback) {
+        if (sink)
+            sink->deletePacket(packet);
+        else if (deleteL3Callback) {
             deleteL3Callback(packet);
         }
     }
 
     void deletePayload (L2Packet::Payload * payload) {
-        if (deleteL2PayloadCallback) {
+        if (payload != nullptr && payload->getArena() != nullptr)
+            return;
+        if (sink)
+            sink->deletePayload(payload);
+        else if (deleteL2PayloadCallback) {
             deleteL2PayloadCallback(payload);
         }
 	}
 
     L2Packet* deepCopy(L2Packet * packet) {
+	    if (sink)
+	        return sink->deepCopy(packet);
 	    if(copyL2Callback) {
 	        return copyL2Callback(packet);
 	    }
@@ -79,6 +230,8 @@ public:
 	}
 
     L2Packet::Payload* deepCopy(L2Packet::Payload * payload) {
+        if (sink)
+            return sink->deepCopy(payload);
         if(copyL2PayloadCallback) {
             return copyL2PayloadCallback(payload);
         }
@@ -86,6 +239,8 @@ public:
 		
 	}
     SimulatorPosition getHostPosition() {
+        if (sink)
+            return sink->getHostPosition();
         if(getPositionCallback) {
             return getPositionCallback();
         }
@@ -95,6 +250,7 @@ public:
 	std::function<double()> getTimeCallback;
 	std::function<void(double)> scheduleAtCallback;
 	std::function<void(std::string, double)> emitCallback;
+	std::function<void(const SignalEmission*, size_t)> emitBatchCallback;
 	std::function<void(std::string)> debugCallback;
     std::function<void(TUHH_INTAIRNET_MCSOTDMA::L2Packet *)> deleteL2Callback;
     std::function<void(L3Packet *)> deleteL3Callback;
@@ -124,6 +280,15 @@ public:
 		emitCallback = callback;
 	}
 
+	/**
+	 * Once registered, emitted values are buffered and passed on in batches through flushEmissions(), instead of through the per-value emit callback.
+	 * Use getSignalName() to resolve handles.
+	 * @param callback
+	 */
+	void registerEmitBatchCallback(std::function<void(const SignalEmission*, size_t)> callback) {
+		emitBatchCallback = callback;
+	}
+
 	void registerDebugMessageCallback(std::function<void(std::string)> callback) {
 		debugCallback = callback;
 	}
@@ -150,6 +315,75 @@ public:
     void registerGetPositionCallback(std::function<SimulatorPosition()> callback) {
 	    getPositionCallback = callback;
 	}
+
+protected:
+	/** The values buffered by emit(). Keeps a process-wide count of non-empty buffers for isAnyEmissionPending(). Copies take over the values buffered so far. */
+	class PendingEmissions {
+	public:
+		PendingEmissions() = default;
+
+		PendingEmissions(const PendingEmissions& other) : values(other.values) {
+			if (!values.empty())
+				getNumNonEmpty().fetch_add(1, std::memory_order_relaxed);
+		}
+
+		PendingEmissions& operator=(const PendingEmissions& other) {
+			if (this != &other) {
+				clear();
+				values = other.values;
+				if (!values.empty())
+					getNumNonEmpty().fetch_add(1, std::memory_order_relaxed);
+			}
+			return *this;
+		}
+
+		~PendingEmissions() {
+			clear();
+		}
+
+		void push(SignalHandle handle, double value) {
+			if (values.empty())
+				getNumNonEmpty().fetch_add(1, std::memory_order_relaxed);
+			values.emplace_back(handle, value);
+		}
+
+		void clear() {
+			if (!values.empty()) {
+				values.clear();
+				getNumNonEmpty().fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		bool empty() const {
+			return values.empty();
+		}
+
+		size_t size() const {
+			return values.size();
+		}
+
+		const SignalEmission* data() const {
+			return values.data();
+		}
+
+		static bool isAnyNonEmpty() {
+			return getNumNonEmpty().load(std::memory_order_relaxed) > 0;
+		}
+
+	private:
+		static std::atomic<size_t>& getNumNonEmpty() {
+			static std::atomic<size_t> num_non_empty(0);
+			return num_non_empty;
+		}
+
+		std::vector<SignalEmission> values;
+	};
+
+	IOmnetSink* sink = nullptr;
+	std::vector<std::string> signal_names;
+	std::unordered_map<std::string, SignalHandle> signal_handles;
+	PendingEmissions pending_emissions;
+	size_t max_pending_emissions = 1024;
 };
 
 #endif //INTAIRNET_LINKLAYER_GLUE_IOMNETPLUGGABLE_HPP
@@ -0,0 +1,78 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_IOMNETSINK_HPP
+#define INTAIRNET_LINKLAYER_GLUE_IOMNETSINK_HPP
+
+#include <string>
+#include "L2Packet.hpp"
+#include "L3Packet.hpp"
+#include "SimulatorPosition.hpp"
+
+/**
+ * Backend through which an IOmnetPluggable reaches the simulator.
+ * An embedding simulator implements this once and hands it to each IOmnetPluggable through setSink(),
+ * so that every call is a single virtual call instead of going through a std::function.
+ * Defaults mirror IOmnetPluggable's behaviour when no callback is registered.
+ */
+class IOmnetSink {
+public:
+	/** Integer handle of a signal name, see IOmnetPluggable::registerSignal(). */
+	typedef unsigned int SignalHandle;
+
+	virtual ~IOmnetSink() = default;
+
+	virtual double getTime() = 0;
+
+	virtual void scheduleAt(double /* time */) {}
+
+	/**
+	 * Called once for each signal name, before the first emission of its handle.
+	 * Lets the simulator resolve the name, e.g. to an OMNeT++ signal ID, a single time.
+	 * @param handle
+	 * @param event_name
+	 */
+	virtual void onSignalRegistered(SignalHandle /* handle */, const std::string& /* event_name */) {}
+
+	virtual void emit(SignalHandle handle, double value) = 0;
+
+	/** @return Whether debug() does anything, so that callers can skip building messages. */
+	virtual bool isDebugEnabled() const {
+		return false;
+	}
+
+	virtual void debug(const std::string& /* message */) {}
+
+	virtual void deletePacket(TUHH_INTAIRNET_MCSOTDMA::L2Packet* /* packet */) {}
+
+	virtual void deletePacket(L3Packet* /* packet */) {}
+
+	virtual void deletePayload(TUHH_INTAIRNET_MCSOTDMA::L2Packet::Payload* /* payload */) {}
+
+	virtual TUHH_INTAIRNET_MCSOTDMA::L2Packet* deepCopy(TUHH_INTAIRNET_MCSOTDMA::L2Packet* packet) {
+		return packet;
+	}
+
+	virtual TUHH_INTAIRNET_MCSOTDMA::L2Packet::Payload* deepCopy(TUHH_INTAIRNET_MCSOTDMA::L2Packet::Payload* payload) {
+		return payload;
+	}
+
+	virtual TUHH_INTAIRNET_MCSOTDMA::SimulatorPosition getHostPosition() {
+		return TUHH_INTAIRNET_MCSOTDMA::SimulatorPosition(0, 0, 0);
+	}
+};
+
+#endif //INTAIRNET_LINKLAYER_GLUE_IOMNETSINK_HPP
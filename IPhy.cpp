@@ -19,11 +19,19 @@
 
 using namespace TUHH_INTAIRNET_MCSOTDMA;
 
+IPhy::IPhy(size_t num_receivers, size_t reservation_horizon) : num_receivers(num_receivers), receivers(num_receivers), transmitter_reservations(reservation_horizon), receiver_reservations(num_receivers, SlotReservationBitmap(reservation_horizon)) {
+	rx_frequencies.reserve(num_receivers);
+}
+
 void IPhy::onReception(L2Packet* packet, uint64_t center_frequency) {
 	assert(upper_layer && "IPhy::onReception for unset upper layer.");
 	upper_layer->receiveFromLower(packet, center_frequency);
 }
 
+void IPhy::onSharedReception(L2PacketReception reception, uint64_t center_frequency) {
+	onReception(reception.release(), center_frequency);
+}
+
 IMac* IPhy::getUpperLayer() {
 	return this->upper_layer;
 }
@@ -37,11 +45,32 @@ void IPhy::setRadio(IRadio* radio) {
 }
 
 void IPhy::tuneReceiver(uint64_t center_frequency) {
-	if (rx_frequencies.size() == num_receivers)
+	if (receivers.getNumTuned() == num_receivers)
 		throw std::runtime_error("IPhy::tuneReceiver exceeds number of available receivers.");
+	receivers.tune(center_frequency);
 	rx_frequencies.push_back(center_frequency);
 }
 
+bool IPhy::isTunedTo(uint64_t center_frequency) const {
+	return receivers.isTunedTo(center_frequency);
+}
+
+size_t IPhy::getNumReceivers() const {
+	return num_receivers;
+}
+
 void IPhy::update(uint64_t num_slots) {
 	rx_frequencies.clear();
+	receivers.clear();
+	transmitter_reservations.advance(num_slots);
+	for (auto& reservations : receiver_reservations)
+		reservations.advance(num_slots);
+}
+
+SlotReservationBitmap& IPhy::getTransmitterReservations() {
+	return transmitter_reservations;
+}
+
+SlotReservationBitmap& IPhy::getReceiverReservations(size_t receiver) {
+	return receiver_reservations.at(receiver);
 }
@@ -19,7 +19,10 @@
 
 #include <cassert>
 #include "L2Packet.hpp"
+#include "L2PacketReception.hpp"
 #include "IRadio.hpp"
+#include "SlotReservationBitmap.hpp"
+#include "ReceiverBank.hpp"
 
 namespace TUHH_INTAIRNET_MCSOTDMA {
 
@@ -30,6 +33,12 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 	 */
 	class IPhy {
 	public:
+		/**
+		 * @param num_receivers Number of receivers; by default one broadcast and one point-to-point receiver.
+		 * @param reservation_horizon Number of upcoming slots that the transmitter and receiver reservations cover, see SlotReservationBitmap.
+		 * @throws std::invalid_argument If there are no receivers.
+		 */
+		explicit IPhy(size_t num_receivers = 2, size_t reservation_horizon = 1024);
 
 		virtual ~IPhy() = default;
 
@@ -64,6 +73,7 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		IMac* getUpperLayer();
 
 		/**
+		 * ReservationPhy answers this from the transmitter's reservations.
 		 * @param slot_offset
 		 * @param num_slots
 		 * @return Whether the single transmitter is idle during the specified time range.
@@ -71,12 +81,23 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		virtual bool isTransmitterIdle(unsigned int slot_offset, unsigned int num_slots) const = 0;
 
 		/**
+		 * ReservationPhy answers this from the receivers' reservations.
 		 * @param slot_offset
 		 * @param num_slots
 		 * @return Whether any receiver is idle during the specified time range.
 		 */
 		virtual bool isAnyReceiverIdle(unsigned int slot_offset, unsigned int num_slots) const = 0;
 
+		/** @return Reservations of the transmitter, which are moved forward by update(). */
+		SlotReservationBitmap& getTransmitterReservations();
+
+		/**
+		 * @param receiver Index of the receiver.
+		 * @return Reservations of the receiver, which are moved forward by update().
+		 * @throws std::out_of_range For invalid receiver indices.
+		 */
+		SlotReservationBitmap& getReceiverReservations(size_t receiver);
+
 		/**
 		 * When this PHY receives a packet, it is transformed into a L2Packet* and passed into this function.
 		 * @param packet
@@ -84,6 +105,16 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 */
 		virtual void onReception(L2Packet* packet, uint64_t center_frequency);
 
+		/**
+		 * When this PHY receives a packet that is shared with other receivers, e.g. a broadcast.
+		 * By default, it is released to onReception(L2Packet*, uint64_t), which copies the packet only if it is still shared.
+		 * Override this to inspect the shared packet first, s.t. receptions that are discarded are never copied,
+		 * and to hand it to IMac::receiveSharedFromLower(), s.t. upper layers that only read it never copy it either.
+		 * @param reception
+		 * @param center_frequency
+		 */
+		virtual void onSharedReception(L2PacketReception reception, uint64_t center_frequency);
+
 		virtual void update(uint64_t num_slots);
 
 		/**
@@ -93,13 +124,23 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 */
 		virtual void tuneReceiver(uint64_t center_frequency);
 
+		/**
+		 * @param center_frequency
+		 * @return Whether any receiver is tuned to the frequency during the current time slot.
+		 */
+		bool isTunedTo(uint64_t center_frequency) const;
+
+		size_t getNumReceivers() const;
+
 	protected:
 		IMac* upper_layer = nullptr;
 		IRadio* radio = nullptr;
-		/** Frequencies that receivers are tuned to in this time slot. */
+		/** Frequencies that receivers are tuned to in this time slot, in tuning order. Prefer isTunedTo() for membership tests. */
 		std::vector<uint64_t> rx_frequencies;
-		/** One broadcast and one point-to-point receiver. */
-		const size_t num_receivers = 2;
+		const size_t num_receivers;
+		ReceiverBank receivers;
+		SlotReservationBitmap transmitter_reservations;
+		std::vector<SlotReservationBitmap> receiver_reservations;
 	};
 }
 
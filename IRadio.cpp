@@ -22,6 +22,10 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		phy->onReception(packet, center_frequency);
 	};
 
+	void IRadio::receiveSharedFromChannel(L2PacketReception reception, uint64_t center_frequency) {
+		phy->onSharedReception(std::move(reception), center_frequency);
+	}
+
 	void IRadio::setPhy(IPhy* phy) { this->phy = phy; };
 
 	IPhy* IRadio::getPhy() { return phy; };
@@ -18,6 +18,7 @@
 #define INTAIRNET_LINKLAYER_GLUE_IRADIO_HPP
 
 #include "L2Packet.hpp"
+#include "L2PacketReception.hpp"
 
 namespace TUHH_INTAIRNET_MCSOTDMA {
 	class IPhy;
@@ -26,10 +27,19 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 	protected:
 		IPhy* phy = nullptr;
 	public:
+		virtual ~IRadio() = default;
+
 		virtual void sendToChannel(L2Packet* packet, uint64_t center_frequency) = 0;
 
 		virtual void receiveFromChannel(L2Packet* packet, uint64_t center_frequency) = 0;
 
+		/**
+		 * Passes a packet that is shared among all receivers to the PHY, without copying it.
+		 * @param reception
+		 * @param center_frequency
+		 */
+		virtual void receiveSharedFromChannel(L2PacketReception reception, uint64_t center_frequency);
+
 		void setPhy(IPhy* phy);
 
 		IPhy* getPhy();
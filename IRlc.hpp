@@ -19,6 +19,7 @@
 
 #include "MacId.hpp"
 #include "L2Packet.hpp"
+#include "L2PacketReception.hpp"
 #include "L3Packet.hpp"
 #include "IRlc.hpp"
 #include "INet.hpp"
@@ -63,6 +64,15 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 */
 		virtual void receiveFromLower(L2Packet* packet) = 0;
 
+		/**
+		 * When a packet that other receivers share comes in via ARQ; it is read through reception.getPacket() and its descriptor.
+		 * By default, the released packet is passed to receiveFromLower(L2Packet*), which is only copied if other receivers still share it. Override this to read the packet without copying it.
+		 * @param reception Move it on to hold on to the packet beyond this call.
+		 */
+		virtual void receiveSharedFromLower(L2PacketReception reception) {
+			receiveFromLower(reception.release());
+		}
+
 		/**
 		 * Link requests may be injected from the MAC sublayer below, through the ARQ sublayer, into this layer.
 		 * @param packet The L3Packet
@@ -20,6 +20,10 @@ unsigned int InetPacketPayload::getBits() const{
     return size;
 }
 
+bool InetPacketPayload::hasFixedBits() const {
+    return false;
+}
+
 L2Packet::Payload* InetPacketPayload::copy() const {
     auto* copy = new InetPacketPayload();
     copy->size = this->size;
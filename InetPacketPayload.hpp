@@ -34,6 +34,8 @@ public:
     unsigned int getBits() const override;
 
     Payload* copy() const override;
+    /** @return False, as 'size' is adjusted after the payload was added to a packet. */
+    bool hasFixedBits() const override;
     ~InetPacketPayload();
 };
 
@@ -25,13 +25,15 @@
 #include "SequenceNumber.hpp"
 #include "LinkProposal.hpp"
 #include "SlotDuration.hpp"
+#include "ObservedVector.hpp"
+#include "SlotArena.hpp"
 
 namespace TUHH_INTAIRNET_MCSOTDMA {
 
 	/**
 	 * Data Link Layer Headers.
 	 */
-	class L2Header {
+	class L2Header : public ArenaObject, protected SizeObserver {
 	public:
 		enum FrameType {
 			unset,
@@ -61,7 +63,8 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 
 		L2Header() : frame_type(unset) {}
 		explicit L2Header(L2Header::FrameType frame_type) : frame_type(frame_type) {}		
-		L2Header(const L2Header& other) = default;
+		/** The size observer is not copied, as it belongs to the packet that holds 'other'. */
+		L2Header(const L2Header& other) : ArenaObject(), SizeObserver(), frame_type(other.frame_type) {}
 		virtual ~L2Header() = default;
 
 		virtual L2Header* copy() const {
@@ -96,8 +99,26 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 			return frame_type == L2Header::dme_response;
 		}
 
+		/**
+		 * Registers an observer that is notified whenever this header's size changes, e.g. when link messages are added to an L2HeaderSH.
+		 * L2Packet uses this to keep its cached size valid.
+		 * @param observer May be nullptr to unregister.
+		 */
+		void setSizeObserver(SizeObserver* observer) {
+			this->size_observer = observer;
+		}
+
 		/** This frame's type. */
 		const FrameType frame_type;
+
+	protected:
+		void onSizeChanged() override {
+			if (size_observer != nullptr)
+				size_observer->onSizeChanged();
+		}
+
+	protected:
+		SizeObserver* size_observer = nullptr;
 	};
 
 	class L2HeaderSH : public L2Header {
@@ -147,6 +168,9 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 			/** datarates for (direction, priority)-pairs */
 			int datarates = 0;
 
+			/** Largest number of link utilizations or proposals that the 4-bit count fields can announce. */
+			static constexpr size_t max_num_messages = (1u << 4) - 1;
+
 			static unsigned int getBits() {
 				return 4 /* num_proposals */
 				+ 4 /* direction */
@@ -242,9 +266,10 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		/** flag to indicate that requested reception time is saved in this message */
 		bool response_time_rx = false;
 		LinkStatus link_status;
-		std::vector<LinkUtilizationMessage> link_utilizations;
-		std::vector<LinkProposalMessage> link_proposals;
-		std::vector<LinkRequest> link_requests;
+		ObservedVector<LinkUtilizationMessage, LinkStatus::max_num_messages> link_utilizations{this};
+		ObservedVector<LinkProposalMessage, LinkStatus::max_num_messages> link_proposals{this};
+		/** No field limits the number of requests, so only the common case is stored inline. */
+		ObservedVector<LinkRequest, LinkStatus::max_num_messages, true> link_requests{this};
 		LinkReply link_reply;
 		bool is_pkt_end = false, is_pkt_start = false;
 
@@ -296,12 +321,12 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		bool is_pkt_end = false, is_pkt_start = false;
 
 		/** Whether the ARQ protocol is followed for this transmission, i.e. acknowledgements are expected. */
-		bool use_arq;
+		bool use_arq = false;
 		/** ARQ sequence number. */
 		SequenceNumber seqno;
 		/** ARQ acknowledgement. */
 		SequenceNumber seqno_next_expected;
-		unsigned int arq_ack_slot;
+		unsigned int arq_ack_slot = 0;
 		/** Selective rejection list. */
         std::array<bool, 16> srej_bitmap = {false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false};
 		std::array<bool, 4> srej = {false, false, false, false};
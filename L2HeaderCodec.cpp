@@ -0,0 +1,400 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <string>
+#include "L2HeaderCodec.hpp"
+#include "BitStream.hpp"
+#include "L2HeaderVisitor.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	const unsigned int FRAME_TYPE_BITS = 3;
+	/** Width of simulator-side integers in the extension section that have no on-air counterpart. */
+	const unsigned int EXT_INT_BITS = 32;
+	const unsigned int EXT_NUM_TX_BITS = 8;
+	/** The number of link requests isn't limited by an on-air field, so the extension uses a wide count. */
+	const unsigned int EXT_NUM_REQUESTS_BITS = 16;
+	const unsigned int SH_EXT_BITS_PER_PROPOSAL = 2*EXT_NUM_TX_BITS;
+	const unsigned int SH_EXT_BITS_PER_REQUEST = 2*EXT_NUM_TX_BITS + 64 /* generation_time */;
+	const unsigned int PP_EXT_BITS = 2*MacId::getBits() + 4 /* srej */ + 4*EXT_INT_BITS;
+
+	uint64_t checkUnsigned(int64_t value, unsigned int num_bits, const char* field) {
+		if (value < 0 || (num_bits < 64 && (uint64_t) value >= (uint64_t(1) << num_bits)))
+			throw std::invalid_argument("L2HeaderCodec: " + std::string(field) + "=" + std::to_string(value) + " does not fit into " + std::to_string(num_bits) + " bits.");
+		return (uint64_t) value;
+	}
+
+	uint64_t checkSigned(int64_t value, unsigned int num_bits, const char* field) {
+		if (num_bits < 64) {
+			int64_t limit = int64_t(1) << (num_bits - 1);
+			if (value < -limit || value >= limit)
+				throw std::invalid_argument("L2HeaderCodec: " + std::string(field) + "=" + std::to_string(value) + " does not fit into " + std::to_string(num_bits) + " bits.");
+			return (uint64_t) value & ((uint64_t(1) << num_bits) - 1);
+		}
+		return (uint64_t) value;
+	}
+
+	void writeMacId(BitWriter& writer, const MacId& id, const char* field) {
+		writer.write(checkSigned(id.getId(), MacId::getBits(), field), MacId::getBits());
+	}
+
+	MacId readMacId(BitReader& reader) {
+		return MacId((int) reader.readSigned(MacId::getBits()));
+	}
+
+	void writeFrameType(BitWriter& writer, L2Header::FrameType frame_type) {
+		writer.write(checkUnsigned(frame_type, FRAME_TYPE_BITS, "frame_type"), FRAME_TYPE_BITS);
+	}
+
+	void readFrameType(BitReader& reader, L2Header::FrameType expected) {
+		auto frame_type = (L2Header::FrameType) reader.read(FRAME_TYPE_BITS);
+		if (frame_type != expected)
+			throw std::invalid_argument("L2HeaderCodec::decode of frame type " + std::to_string(frame_type) + " into a header of type " + std::to_string(expected) + ".");
+	}
+
+	/** slot_offset, slot_duration, period, center_frequency as the link messages carry them. */
+	void writeLinkProposal(BitWriter& writer, const LinkProposal& proposal) {
+		writer.write(checkUnsigned(proposal.slot_offset, 14, "slot_offset"), 14);
+		writer.write(checkUnsigned(proposal.slot_duration, 2, "slot_duration"), 2);
+		writer.write(checkUnsigned(proposal.period, 3, "period"), 3);
+		writer.write(checkUnsigned(proposal.center_frequency, 9, "center_frequency"), 9);
+	}
+
+	void readLinkProposal(BitReader& reader, LinkProposal& proposal) {
+		proposal.slot_offset = (int) reader.read(14);
+		proposal.slot_duration = (SlotDuration) reader.read(2);
+		proposal.period = (int) reader.read(3);
+		proposal.center_frequency = (int) reader.read(9);
+	}
+
+	void writeNumTx(BitWriter& writer, const LinkProposal& proposal) {
+		writer.write(checkUnsigned(proposal.num_tx_initiator, EXT_NUM_TX_BITS, "num_tx_initiator"), EXT_NUM_TX_BITS);
+		writer.write(checkUnsigned(proposal.num_tx_recipient, EXT_NUM_TX_BITS, "num_tx_recipient"), EXT_NUM_TX_BITS);
+	}
+
+	void readNumTx(BitReader& reader, LinkProposal& proposal) {
+		proposal.num_tx_initiator = (int) reader.read(EXT_NUM_TX_BITS);
+		proposal.num_tx_recipient = (int) reader.read(EXT_NUM_TX_BITS);
+	}
+
+	/** LinkRequest and LinkReply share their on-air layout. */
+	template <typename T>
+	void writeLinkEstablishment(BitWriter& writer, const T& message) {
+		writer.write(checkUnsigned(message.modulation, 4, "modulation"), 4);
+		writer.write(checkUnsigned(message.type, 4, "type"), 4);
+		writeMacId(writer, message.dest_id, "dest_id");
+		writeLinkProposal(writer, message.proposed_link);
+		writer.write(checkUnsigned(message.num_forward_bursts, 2, "num_forward_bursts"), 2);
+		writer.write(checkUnsigned(message.num_reverse_bursts, 2, "num_reverse_bursts"), 2);
+	}
+
+	template <typename T>
+	void readLinkEstablishment(BitReader& reader, T& message) {
+		message.modulation = (L2Header::Modulation) reader.read(4);
+		message.type = (int) reader.read(4);
+		message.dest_id = readMacId(reader);
+		readLinkProposal(reader, message.proposed_link);
+		message.num_forward_bursts = (int) reader.read(2);
+		message.num_reverse_bursts = (int) reader.read(2);
+	}
+
+	void verifyOnAirBits(size_t num_bits, unsigned int expected, const char* header_name) {
+		if (num_bits != expected)
+			throw std::logic_error("L2HeaderCodec: on-air section of " + std::string(header_name) + " has " + std::to_string(num_bits) + " bits, but getBits() reports " + std::to_string(expected) + ".");
+	}
+}
+
+unsigned int L2HeaderCodec::getEncodedBits(const L2HeaderSH& header) {
+	return header.getBits()
+		+ header.link_proposals.size() * SH_EXT_BITS_PER_PROPOSAL
+		+ header.link_requests.size() * SH_EXT_BITS_PER_REQUEST;
+}
+
+unsigned int L2HeaderCodec::getEncodedBits(const L2HeaderPP& header) {
+	return header.getBits() + PP_EXT_BITS;
+}
+
+namespace {
+	struct EncodedBitsVisitor {
+		unsigned int operator()(const L2HeaderSH& header) const {
+			return L2HeaderCodec::getEncodedBits(header);
+		}
+
+		unsigned int operator()(const L2HeaderPP& header) const {
+			return L2HeaderCodec::getEncodedBits(header);
+		}
+
+		/** Headers without fields of their own are sent as their frame type. */
+		unsigned int operator()(const L2Header&) const {
+			return FRAME_TYPE_BITS;
+		}
+	};
+
+	struct EncodeVisitor {
+		uint8_t* buffer;
+		size_t num_bytes;
+
+		unsigned int operator()(const L2HeaderSH& header) const {
+			return L2HeaderCodec::encode(header, buffer, num_bytes);
+		}
+
+		unsigned int operator()(const L2HeaderPP& header) const {
+			return L2HeaderCodec::encode(header, buffer, num_bytes);
+		}
+
+		unsigned int operator()(const L2Header& header) const {
+			BitWriter writer = BitWriter(buffer, num_bytes);
+			writeFrameType(writer, header.frame_type);
+			return (unsigned int) writer.getPosition();
+		}
+	};
+}
+
+unsigned int L2HeaderCodec::getEncodedBits(const L2Header& header) {
+	return visit(header, EncodedBitsVisitor());
+}
+
+unsigned int L2HeaderCodec::encode(const L2HeaderSH& header, uint8_t* buffer, size_t num_bytes) {
+	BitWriter writer = BitWriter(buffer, num_bytes);
+	// On-air section.
+	writeFrameType(writer, header.frame_type);
+	// The signature isn't computed, so its bits carry the fixed-size part of the extension.
+	size_t signature_start = writer.getPosition();
+	writer.writeBool(header.request_time_rx);
+	writer.writeBool(header.response_time_rx);
+	writer.writeBool(header.is_pkt_start);
+	writer.writeBool(header.is_pkt_end);
+	const L2Header::Direction& direction = header.link_status.direction;
+	for (bool flag : {direction.North, direction.NorthEast, direction.East, direction.SouthEast, direction.South, direction.SouthWest, direction.West, direction.NorthWest})
+		writer.writeBool(flag);
+	writer.writeDouble(header.position.latitude);
+	writer.writeDouble(header.position.longitude);
+	writer.writeDouble(header.position.altitude);
+	writer.writeBool(header.position.odd);
+	writer.writeDouble(header.position.encodedPosition.x);
+	writer.writeDouble(header.position.encodedPosition.y);
+	writer.writeDouble(header.position.encodedPosition.z);
+	writer.write(checkUnsigned(header.link_requests.size(), EXT_NUM_REQUESTS_BITS, "num_link_requests"), EXT_NUM_REQUESTS_BITS);
+	writeLinkEstablishment(writer, header.link_reply);
+	writeNumTx(writer, header.link_reply.proposed_link);
+	writer.writeZeros(signature_start + L2HeaderSH::Signature::getBits() - writer.getPosition());
+	writeMacId(writer, header.src_id, "src_id");
+	writer.write(checkUnsigned(header.slot_offset, 14, "slot_offset"), 14);
+	writer.write(checkUnsigned(header.slot_duration, 2, "slot_duration"), 2);
+	// CPR encoding isn't performed, see CPRPosition; the exact position is part of the extension.
+	writer.writeZeros(header.position.getBits());
+	writer.write(checkUnsigned(header.time_src, 3, "time_src"), 3);
+	writer.write(checkUnsigned(header.num_hops, 4, "num_hops"), 4);
+	writer.write((uint64_t) (int64_t) header.time_tx, 64);
+	writer.write(header.link_proposals.size(), 4);
+	writer.writeZeros(4); // eight direction flags don't fit into four bits, so they're part of the extension
+	writer.write(header.link_utilizations.size(), 4);
+	writer.writeZeros(16*8 - 32);
+	writer.write((uint32_t) header.link_status.datarates, 32);
+	for (const auto& utilization : header.link_utilizations) {
+		writer.write(checkUnsigned(utilization.slot_offset, 14, "slot_offset"), 14);
+		writer.write(checkUnsigned(utilization.slot_duration, 2, "slot_duration"), 2);
+		writer.write(checkUnsigned(utilization.num_bursts_forward, 2, "num_bursts_forward"), 2);
+		writer.write(checkUnsigned(utilization.num_bursts_reverse, 2, "num_bursts_reverse"), 2);
+		writer.write(checkUnsigned(utilization.period, 3, "period"), 3);
+		writer.write(checkUnsigned(utilization.center_frequency, 9, "center_frequency"), 9);
+		writer.write(checkUnsigned(utilization.timeout, 8, "timeout"), 8);
+	}
+	for (const auto& proposal : header.link_proposals) {
+		const LinkProposal& link = proposal.proposed_link;
+		writer.write(checkUnsigned(link.slot_offset, 14, "slot_offset"), 14);
+		writer.write(checkUnsigned(link.slot_duration, 2, "slot_duration"), 2);
+		writer.write(checkUnsigned(proposal.noise, 4, "noise"), 4);
+		writer.write(checkUnsigned(link.period, 3, "period"), 3);
+		writer.write(checkUnsigned(link.center_frequency, 9, "center_frequency"), 9);
+	}
+	for (const auto& request : header.link_requests)
+		writeLinkEstablishment(writer, request);
+	verifyOnAirBits(writer.getPosition(), header.getBits(), "L2HeaderSH");
+	// Variable-size part of the extension.
+	for (const auto& proposal : header.link_proposals)
+		writeNumTx(writer, proposal.proposed_link);
+	for (const auto& request : header.link_requests) {
+		writeNumTx(writer, request.proposed_link);
+		writer.write(request.generation_time, 64);
+	}
+	return (unsigned int) writer.getPosition();
+}
+
+unsigned int L2HeaderCodec::decode(const uint8_t* buffer, size_t num_bytes, L2HeaderSH& header) {
+	BitReader reader = BitReader(buffer, num_bytes);
+	readFrameType(reader, header.frame_type);
+	size_t signature_start = reader.getPosition();
+	header.request_time_rx = reader.readBool();
+	header.response_time_rx = reader.readBool();
+	header.is_pkt_start = reader.readBool();
+	header.is_pkt_end = reader.readBool();
+	L2Header::Direction& direction = header.link_status.direction;
+	for (bool* flag : {&direction.North, &direction.NorthEast, &direction.East, &direction.SouthEast, &direction.South, &direction.SouthWest, &direction.West, &direction.NorthWest})
+		*flag = reader.readBool();
+	header.position.latitude = reader.readDouble();
+	header.position.longitude = reader.readDouble();
+	header.position.altitude = reader.readDouble();
+	header.position.odd = reader.readBool();
+	header.position.encodedPosition.x = reader.readDouble();
+	header.position.encodedPosition.y = reader.readDouble();
+	header.position.encodedPosition.z = reader.readDouble();
+	auto num_requests = (size_t) reader.read(EXT_NUM_REQUESTS_BITS);
+	readLinkEstablishment(reader, header.link_reply);
+	readNumTx(reader, header.link_reply.proposed_link);
+	reader.skip(signature_start + L2HeaderSH::Signature::getBits() - reader.getPosition());
+	header.src_id = readMacId(reader);
+	header.slot_offset = (unsigned int) reader.read(14);
+	header.slot_duration = (SlotDuration) reader.read(2);
+	reader.skip(header.position.getBits());
+	header.time_src = (int) reader.read(3);
+	header.num_hops = (int) reader.read(4);
+	header.time_tx = (int) (int64_t) reader.read(64);
+	header.link_status.num_proposals = (int) reader.read(4);
+	reader.skip(4);
+	header.link_status.num_utilizations = (int) reader.read(4);
+	reader.skip(16*8 - 32);
+	header.link_status.datarates = (int) (uint32_t) reader.read(32);
+	header.link_utilizations.clear();
+	for (int i = 0; i < header.link_status.num_utilizations; i++) {
+		L2HeaderSH::LinkUtilizationMessage utilization;
+		utilization.slot_offset = (int) reader.read(14);
+		utilization.slot_duration = (SlotDuration) reader.read(2);
+		utilization.num_bursts_forward = (int) reader.read(2);
+		utilization.num_bursts_reverse = (int) reader.read(2);
+		utilization.period = (int) reader.read(3);
+		utilization.center_frequency = (int) reader.read(9);
+		utilization.timeout = (int) reader.read(8);
+		header.link_utilizations.push_back(utilization);
+	}
+	header.link_proposals.clear();
+	for (int i = 0; i < header.link_status.num_proposals; i++) {
+		L2HeaderSH::LinkProposalMessage proposal;
+		LinkProposal& link = proposal.proposed_link;
+		link.slot_offset = (int) reader.read(14);
+		link.slot_duration = (SlotDuration) reader.read(2);
+		proposal.noise = (int) reader.read(4);
+		link.period = (int) reader.read(3);
+		link.center_frequency = (int) reader.read(9);
+		header.link_proposals.push_back(proposal);
+	}
+	header.link_requests.clear();
+	for (size_t i = 0; i < num_requests; i++) {
+		L2HeaderSH::LinkRequest request;
+		readLinkEstablishment(reader, request);
+		header.link_requests.push_back(request);
+	}
+	for (auto& proposal : header.link_proposals)
+		readNumTx(reader, proposal.proposed_link);
+	for (auto& request : header.link_requests) {
+		readNumTx(reader, request.proposed_link);
+		request.generation_time = reader.read(64);
+	}
+	return (unsigned int) reader.getPosition();
+}
+
+unsigned int L2HeaderCodec::encode(const L2HeaderPP& header, uint8_t* buffer, size_t num_bytes) {
+	BitWriter writer = BitWriter(buffer, num_bytes);
+	// On-air section.
+	writeFrameType(writer, header.frame_type);
+	writer.writeBool(header.use_arq);
+	writer.writeBool(header.is_pkt_start);
+	writer.writeBool(header.is_pkt_end);
+	writer.write(header.seqno.get(), 8);
+	writer.write(header.seqno_next_expected.get(), 8);
+	for (bool flag : header.srej_bitmap)
+		writer.writeBool(flag);
+	writer.writeZeros(2);
+	verifyOnAirBits(writer.getPosition(), header.getBits(), "L2HeaderPP");
+	// Extension section.
+	writeMacId(writer, header.src_id, "src_id");
+	writeMacId(writer, header.dest_id, "dest_id");
+	for (bool flag : header.srej)
+		writer.writeBool(flag);
+	writer.write(header.arq_ack_slot, EXT_INT_BITS);
+	writer.write(header.payload_length, EXT_INT_BITS);
+	writer.write(header.payload_offset, EXT_INT_BITS);
+	writer.write(header.packet_id, EXT_INT_BITS);
+	return (unsigned int) writer.getPosition();
+}
+
+unsigned int L2HeaderCodec::decode(const uint8_t* buffer, size_t num_bytes, L2HeaderPP& header) {
+	BitReader reader = BitReader(buffer, num_bytes);
+	readFrameType(reader, header.frame_type);
+	header.use_arq = reader.readBool();
+	header.is_pkt_start = reader.readBool();
+	header.is_pkt_end = reader.readBool();
+	header.seqno = SequenceNumber((uint8_t) reader.read(8));
+	header.seqno_next_expected = SequenceNumber((uint8_t) reader.read(8));
+	for (bool& flag : header.srej_bitmap)
+		flag = reader.readBool();
+	reader.skip(2);
+	header.src_id = readMacId(reader);
+	header.dest_id = readMacId(reader);
+	for (bool& flag : header.srej)
+		flag = reader.readBool();
+	header.arq_ack_slot = (unsigned int) reader.read(EXT_INT_BITS);
+	header.payload_length = (unsigned int) reader.read(EXT_INT_BITS);
+	header.payload_offset = (unsigned int) reader.read(EXT_INT_BITS);
+	header.packet_id = (unsigned int) reader.read(EXT_INT_BITS);
+	return (unsigned int) reader.getPosition();
+}
+
+unsigned int L2HeaderCodec::encode(const L2Header& header, uint8_t* buffer, size_t num_bytes) {
+	return visit(header, EncodeVisitor{buffer, num_bytes});
+}
+
+L2Header::FrameType L2HeaderCodec::peekFrameType(const uint8_t* buffer, size_t num_bytes) {
+	BitReader reader = BitReader(buffer, num_bytes);
+	return (L2Header::FrameType) reader.read(FRAME_TYPE_BITS);
+}
+
+L2Header* L2HeaderCodec::decode(const uint8_t* buffer, size_t num_bytes, unsigned int* num_bits) {
+	L2Header* header;
+	unsigned int bits;
+	L2Header::FrameType frame_type = peekFrameType(buffer, num_bytes);
+	switch (frame_type) {
+		case L2Header::FrameType::broadcast: {
+			auto* header_sh = new L2HeaderSH();
+			try {
+				bits = decode(buffer, num_bytes, *header_sh);
+			} catch (...) {
+				delete header_sh;
+				throw;
+			}
+			header = header_sh;
+			break;
+		}
+		case L2Header::FrameType::unicast: {
+			auto* header_pp = new L2HeaderPP();
+			try {
+				bits = decode(buffer, num_bytes, *header_pp);
+			} catch (...) {
+				delete header_pp;
+				throw;
+			}
+			header = header_pp;
+			break;
+		}
+		case L2Header::FrameType::dme_request: {header = new L2HeaderDMERequest(); bits = FRAME_TYPE_BITS; break;}
+		case L2Header::FrameType::dme_response: {header = new L2HeaderDMEResponse(); bits = FRAME_TYPE_BITS; break;}
+		default: {header = new L2Header(frame_type); bits = FRAME_TYPE_BITS; break;}
+	}
+	if (num_bits != nullptr)
+		*num_bits = bits;
+	return header;
+}
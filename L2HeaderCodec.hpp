@@ -0,0 +1,100 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_L2HEADERCODEC_HPP
+#define INTAIRNET_LINKLAYER_GLUE_L2HEADERCODEC_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include "L2Header.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Bit-packed encoder and decoder for the Data Link Layer headers, which writes into and reads from caller-provided byte buffers.
+	 *
+	 * An encoded header starts with its on-air section, which holds exactly the fields counted by the header's getBits(), in that order and at those widths.
+	 * Its length is verified against getBits() during encoding.
+	 * Everything the on-air model doesn't account for is encoded as well, s.t. decoding restores the complete header:
+	 * - The signature isn't computed by the simulator, so an SH header's signature bits carry its flags, direction, exact position, link reply and number of link requests.
+	 * - The remaining values (e.g. a PP header's IDs, LinkRequest::generation_time) follow the on-air section.
+	 *
+	 * CPR encoding isn't performed either, so the on-air position bits are written as zeros.
+	 * Fields whose value doesn't fit into their on-air width make encoding fail instead of being truncated.
+	 * The numbers of link utilizations and proposals are taken from the vector sizes and written into LinkStatus.
+	 */
+	class L2HeaderCodec {
+	public:
+		/**
+		 * @param header
+		 * @return Number of bits the encoded header occupies.
+		 */
+		static unsigned int getEncodedBits(const L2Header& header);
+		static unsigned int getEncodedBits(const L2HeaderSH& header);
+		static unsigned int getEncodedBits(const L2HeaderPP& header);
+
+		/**
+		 * @param header
+		 * @return Number of bytes required to hold the encoded header.
+		 */
+		static size_t getEncodedBytes(const L2Header& header) {
+			return (getEncodedBits(header) + 7) / 8;
+		}
+
+		/**
+		 * Encodes a header of any type, dispatching on its frame type.
+		 * @param header
+		 * @param buffer Where the header is written to, starting at its first bit.
+		 * @param num_bytes Size of the buffer.
+		 * @return Number of bits written.
+		 * @throws std::out_of_range If the buffer is too small.
+		 * @throws std::invalid_argument If a field's value cannot be represented in its width.
+		 */
+		static unsigned int encode(const L2Header& header, uint8_t* buffer, size_t num_bytes);
+		static unsigned int encode(const L2HeaderSH& header, uint8_t* buffer, size_t num_bytes);
+		static unsigned int encode(const L2HeaderPP& header, uint8_t* buffer, size_t num_bytes);
+
+		/**
+		 * Decodes into an existing header, so that no allocation is required.
+		 * @param buffer
+		 * @param num_bytes
+		 * @param header Is overwritten with the decoded values.
+		 * @return Number of bits read.
+		 * @throws std::invalid_argument If the encoded frame type doesn't match the header's type.
+		 * @throws std::out_of_range If the buffer is too short.
+		 */
+		static unsigned int decode(const uint8_t* buffer, size_t num_bytes, L2HeaderSH& header);
+		static unsigned int decode(const uint8_t* buffer, size_t num_bytes, L2HeaderPP& header);
+
+		/**
+		 * Decodes a header of any type.
+		 * @param buffer
+		 * @param num_bytes
+		 * @param num_bits If not nullptr, the number of bits read is written here.
+		 * @return A newly allocated header of the encoded type.
+		 */
+		static L2Header* decode(const uint8_t* buffer, size_t num_bytes, unsigned int* num_bits = nullptr);
+
+		/**
+		 * @param buffer
+		 * @param num_bytes
+		 * @return The frame type of the encoded header.
+		 */
+		static L2Header::FrameType peekFrameType(const uint8_t* buffer, size_t num_bytes);
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_L2HEADERCODEC_HPP
@@ -0,0 +1,59 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_L2HEADERVISITOR_HPP
+#define INTAIRNET_LINKLAYER_GLUE_L2HEADERVISITOR_HPP
+
+#include <type_traits>
+#include <utility>
+#include "L2Header.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/** L2Header, or const L2Header if 'Header' is const. */
+	template <typename Header>
+	using L2HeaderBaseOf = typename std::conditional<std::is_const<Header>::value, const L2Header, L2Header>::type;
+
+	/** 'Target', or const 'Target' if 'Header' is const. */
+	template <typename Target, typename Header>
+	using L2HeaderCastOf = typename std::conditional<std::is_const<Header>::value, const Target, Target>::type;
+
+	/**
+	 * Calls 'visitor' with 'header' cast to its concrete type, chosen by its frame type from the header classes in L2Header.hpp:
+	 * broadcast -> L2HeaderSH, unicast -> L2HeaderPP, dme_request -> L2HeaderDMERequest, dme_response -> L2HeaderDMEResponse.
+	 * All other frame types have no header class of their own and are passed as L2Header.
+	 * The dispatch is resolved at compile time, so that e.g. a function object with one overload per header type can be inlined instead of using virtual calls and casts.
+	 * Overloads that a visitor doesn't provide fall back to its L2Header overload.
+	 * Constness of 'header' is kept.
+	 * @param header
+	 * @param visitor Must be callable with every header type and return the same type for all of them.
+	 * @return Whatever the visitor returns.
+	 */
+	template <typename Header, typename Visitor>
+	inline auto visit(Header& header, Visitor&& visitor) -> decltype(visitor(std::declval<L2HeaderBaseOf<Header>&>())) {
+		static_assert(std::is_base_of<L2Header, typename std::remove_const<Header>::type>::value, "visit() requires an L2Header.");
+		L2HeaderBaseOf<Header>& base = header;
+		switch (base.frame_type) {
+			case L2Header::FrameType::broadcast: return visitor(static_cast<L2HeaderCastOf<L2HeaderSH, Header>&>(base));
+			case L2Header::FrameType::unicast: return visitor(static_cast<L2HeaderCastOf<L2HeaderPP, Header>&>(base));
+			case L2Header::FrameType::dme_request: return visitor(static_cast<L2HeaderCastOf<L2HeaderDMERequest, Header>&>(base));
+			case L2Header::FrameType::dme_response: return visitor(static_cast<L2HeaderCastOf<L2HeaderDMEResponse, Header>&>(base));
+			default: return visitor(base);
+		}
+	}
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_L2HEADERVISITOR_HPP
@@ -14,42 +14,267 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <cassert>
 #include "L2Packet.hpp"
+#include "SlotArena.hpp"
+#include "L2HeaderVisitor.hpp"
 
 using namespace TUHH_INTAIRNET_MCSOTDMA;
 
+namespace {
+	struct DestinationVisitor {
+		MacId operator()(const L2HeaderSH&) const {
+			return SYMBOLIC_LINK_ID_BROADCAST;
+		}
+
+		MacId operator()(const L2HeaderPP& header) const {
+			return header.dest_id;
+		}
+
+		/** Other unicast frame types have no header class that carries a destination. */
+		MacId operator()(const L2Header&) const {
+			return SYMBOLIC_ID_UNSET;
+		}
+	};
+
+	struct OriginVisitor {
+		const MacId& operator()(const L2HeaderSH& header) const {
+			return header.src_id;
+		}
+
+		const MacId& operator()(const L2HeaderPP& header) const {
+			return header.src_id;
+		}
+
+		const MacId& operator()(const L2Header&) const {
+			return SYMBOLIC_ID_UNSET;
+		}
+	};
+}
+
 L2Packet::L2Packet() = default;
 
-L2Packet::L2Packet(const L2Packet& other) : headers(other.headers), payloads(other.payloads), callbacks(other.callbacks), hasChannelError(hasChannelError) {}
+void L2Packet::destroy(L2Packet* packet) {
+	if (packet != nullptr && packet->getArena() == nullptr)
+		delete packet;
+}
+
+L2Packet::L2Packet(L2Packet&& other) noexcept : hasChannelError(other.hasChannelError), receptionDist(other.receptionDist), snr(other.snr), headers(std::move(other.headers)), payloads(std::move(other.payloads)), descriptors(std::move(other.descriptors)), bits(other.bits), bits_valid(other.bits_valid), fixed_payload_total(other.fixed_payload_total), variable_payloads(std::move(other.variable_payloads)), payloads_changed(other.payloads_changed), callbacks(std::move(other.callbacks)) {
+	other.headers.clear();
+	other.payloads.clear();
+	other.descriptors.clear();
+	other.callbacks.clear();
+	other.bits = 0;
+	other.bits_valid = true;
+	other.fixed_payload_total = 0;
+	other.variable_payloads.clear();
+	other.payloads_changed = false;
+	observeHeaders();
+}
+
+L2Packet& L2Packet::operator=(L2Packet&& other) noexcept {
+	if (this == &other)
+		return *this;
+	releaseAll();
+	hasChannelError = other.hasChannelError;
+	receptionDist = other.receptionDist;
+	snr = other.snr;
+	headers = std::move(other.headers);
+	payloads = std::move(other.payloads);
+	descriptors = std::move(other.descriptors);
+	bits = other.bits;
+	bits_valid = other.bits_valid;
+	fixed_payload_total = other.fixed_payload_total;
+	variable_payloads = std::move(other.variable_payloads);
+	payloads_changed = other.payloads_changed;
+	callbacks = std::move(other.callbacks);
+	other.headers.clear();
+	other.payloads.clear();
+	other.descriptors.clear();
+	other.callbacks.clear();
+	other.bits = 0;
+	other.bits_valid = true;
+	other.fixed_payload_total = 0;
+	other.variable_payloads.clear();
+	other.payloads_changed = false;
+	observeHeaders();
+	return *this;
+}
 
 L2Packet* L2Packet::copy() const {
 	auto* copy = new L2Packet();
 	copy->hasChannelError = this->hasChannelError;
-	for (const auto* header : headers)
-		copy->headers.push_back(header == nullptr ? nullptr : header->copy());
-	for (const auto* payload : payloads)
-		copy->payloads.push_back(payload == nullptr ? nullptr : payload->copy());
+	for (size_t i = 0; i < headers.size(); i++)
+		copy->addMessage(headers.at(i) == nullptr ? nullptr : headers.at(i)->copy(), payloads.at(i) == nullptr ? nullptr : payloads.at(i)->copy());
 	return copy;
 }
 
+std::unique_ptr<L2Packet> L2Packet::clone() const {
+	return std::unique_ptr<L2Packet>(copy());
+}
+
 L2Packet::~L2Packet() {
-	for (auto* header : headers)
-		delete header;
+	releaseAll();
+}
+
+void L2Packet::releaseAll() {
+	// Messages that belong to an arena are left to it. If this packet belongs to an arena, too, they may already be destroyed, so they are not touched at all.
+	for (auto* header : headers) {
+		if (header != nullptr && header->getArena() != nullptr && getArena() == nullptr)
+			header->setSizeObserver(nullptr);
+		release(header);
+	}
 	for (auto* payload : payloads)
-		delete payload;
+		release(payload);
+	headers.clear();
+	payloads.clear();
+	descriptors.clear();
+	bits = 0;
+	bits_valid = true;
+	fixed_payload_total = 0;
+	variable_payloads.clear();
+	payloads_changed = false;
+}
+
+void L2Packet::observeHeaders() {
+	for (auto* header : headers)
+		if (header != nullptr)
+			header->setSizeObserver(this);
+}
+
+void L2Packet::describePayloads() const {
+	if (!payloads_changed)
+		return;
+	fixed_payload_total = 0;
+	variable_payloads.clear();
+	for (size_t i = 0; i < descriptors.size(); i++) {
+		const MessageDescriptor payload_descriptor = describe(nullptr, payloads[i]);
+		MessageDescriptor& descriptor = descriptors[i];
+		descriptor.has_payload = payload_descriptor.has_payload;
+		descriptor.fixed_payload_bits = payload_descriptor.fixed_payload_bits;
+		descriptor.payload_bits = payload_descriptor.payload_bits;
+		fixed_payload_total += descriptor.payload_bits;
+		if (descriptor.has_payload && !descriptor.fixed_payload_bits)
+			variable_payloads.push_back(i);
+	}
+	bits_valid = false;
+	payloads_changed = false;
+}
+
+void L2Packet::onSizeChanged() {
+	bits_valid = false;
+}
+
+L2Packet::MessageDescriptor L2Packet::describe(const L2Header* header, const Payload* payload) {
+	MessageDescriptor descriptor;
+	if (header != nullptr) {
+		descriptor.frame_type = header->frame_type;
+		descriptor.has_header = true;
+		// Only the SH's size depends on its contents.
+		descriptor.fixed_header_bits = header->frame_type != L2Header::FrameType::broadcast;
+		descriptor.header_bits = descriptor.fixed_header_bits ? header->getBits() : 0;
+	}
+	if (payload != nullptr) {
+		descriptor.has_payload = true;
+		descriptor.fixed_payload_bits = payload->hasFixedBits();
+		descriptor.payload_bits = descriptor.fixed_payload_bits ? payload->getBits() : 0;
+	}
+	return descriptor;
+}
+
+unsigned int L2Packet::getHeaderBits(size_t index) const {
+	const MessageDescriptor& descriptor = descriptors[index];
+	return descriptor.fixed_header_bits ? descriptor.header_bits : headers[index]->getBits();
+}
+
+unsigned int L2Packet::getCountedBits(size_t index) const {
+	const MessageDescriptor& descriptor = descriptors[index];
+	return descriptor.has_header ? getHeaderBits(index) + descriptor.payload_bits : 0;
+}
+
+void L2Packet::addToTotals() {
+	const size_t index = descriptors.size() - 1;
+	if (bits_valid)
+		bits += getCountedBits(index);
+	fixed_payload_total += descriptors[index].payload_bits;
+	if (descriptors[index].has_payload && !descriptors[index].fixed_payload_bits)
+		variable_payloads.push_back(index);
+}
+
+void L2Packet::removeFromTotals(size_t index) {
+	describePayloads();
+	if (bits_valid)
+		bits -= getCountedBits(index);
+	fixed_payload_total -= descriptors[index].payload_bits;
+	auto it = std::lower_bound(variable_payloads.begin(), variable_payloads.end(), index);
+	if (it != variable_payloads.end() && *it == index)
+		it = variable_payloads.erase(it);
+	// Later messages move up by one.
+	for (; it != variable_payloads.end(); it++)
+		(*it)--;
+}
+
+template <typename T>
+void L2Packet::release(T* message) const {
+	if (message != nullptr && message->getArena() == nullptr)
+		delete message;
 }
 
 void L2Packet::addMessage(L2Header* header, L2Packet::Payload* payload) {
+	describePayloads();
+	descriptors.push_back(describe(header, payload));
 	headers.push_back(header);
 	payloads.push_back(payload);
+	if (header != nullptr)
+		header->setSizeObserver(this);
+	addToTotals();
 }
 
 void L2Packet::addMessage(std::pair<L2Header*, Payload*> message) {
 	this->addMessage(message.first, message.second);
 }
 
+void L2Packet::addMessage(std::unique_ptr<L2Header> header, std::unique_ptr<Payload> payload) {
+	describePayloads();
+	headers.reserve(headers.size() + 1);
+	payloads.reserve(payloads.size() + 1);
+	variable_payloads.reserve(variable_payloads.size() + 1);
+	descriptors.push_back(describe(header.get(), payload.get()));
+	// Capacity is reserved, so the push_backs cannot throw and ownership is never lost.
+	headers.push_back(header.release());
+	payloads.push_back(payload.release());
+	if (headers.back() != nullptr)
+		headers.back()->setSizeObserver(this);
+	addToTotals();
+}
+
+std::pair<std::unique_ptr<L2Header>, std::unique_ptr<L2Packet::Payload>> L2Packet::releaseMessage(size_t index) {
+	if (index >= this->headers.size() || index >= this->payloads.size())
+		throw std::invalid_argument("L2Packet::releaseMessage for index out of bounds.");
+	L2Header* header = headers.at(index);
+	Payload* payload = payloads.at(index);
+	removeFromTotals(index);
+	if (header != nullptr)
+		header->setSizeObserver(nullptr);
+	std::unique_ptr<L2Header> released_header;
+	std::unique_ptr<Payload> released_payload;
+	if (header != nullptr && header->getArena() != nullptr)
+		released_header.reset(header->copy());
+	else
+		released_header.reset(header);
+	if (payload != nullptr && payload->getArena() != nullptr)
+		released_payload.reset(payload->copy());
+	else
+		released_payload.reset(payload);
+	this->headers.erase(this->headers.begin() + index);
+	this->payloads.erase(this->payloads.begin() + index);
+	this->descriptors.erase(this->descriptors.begin() + index);
+	return {std::move(released_header), std::move(released_payload)};
+}
+
 std::vector<L2Packet::Payload*>& L2Packet::getPayloads() {
+	payloads_changed = true;
 	return this->payloads;
 }
 
@@ -57,33 +282,48 @@ const std::vector<L2Header*>& L2Packet::getHeaders() {
 	return this->headers;
 }
 
+const std::vector<L2Packet::Payload*>& L2Packet::getPayloads() const {
+	return this->payloads;
+}
+
+const std::vector<L2Header*>& L2Packet::getHeaders() const {
+	return this->headers;
+}
+
+const std::vector<L2Packet::MessageDescriptor>& L2Packet::getDescriptors() const {
+	describePayloads();
+	return this->descriptors;
+}
+
 unsigned int L2Packet::getBits() const {
-	unsigned int bits = 0;
-	for (size_t i = 0; i < headers.size(); i++) {
-		if (headers.at(i) == nullptr)
-			continue;
-		L2Packet::Payload* payload = payloads.at(i);
-		bits += headers.at(i)->getBits() + (payload == nullptr ? 0 : payload->getBits());
+	describePayloads();
+	if (!bits_valid) {
+		bits = 0;
+		for (size_t i = 0; i < descriptors.size(); i++)
+			bits += getCountedBits(i);
+		bits_valid = true;
 	}
-	return bits;
+	unsigned int variable_bits = 0;
+	for (size_t index : variable_payloads)
+		if (descriptors[index].has_header)
+			variable_bits += payloads[index]->getBits();
+	return bits + variable_bits;
 }
 
 MacId L2Packet::getDestination() const {	
-	for (const L2Header *header : headers) {
-		if (header->isBroadcastType())
-			return SYMBOLIC_LINK_ID_BROADCAST;		
-		else if (header->isUnicastType())
-			return ((L2HeaderPP*) header)->dest_id;
+	for (size_t i = 0; i < descriptors.size(); i++) {
+		const L2Header::FrameType frame_type = descriptors[i].frame_type;
+		if (frame_type == L2Header::broadcast || frame_type == L2Header::link_establishment_reply || frame_type == L2Header::link_establishment_request || frame_type == L2Header::unicast)
+			return visit(*headers[i], DestinationVisitor());
 	}
 	// Default to UNSET.
 	return SYMBOLIC_ID_UNSET;
 }
 
 const MacId& L2Packet::getOrigin() const {
-	if (headers.empty())
+	if (headers.empty() || headers.at(0) == nullptr)
 		return SYMBOLIC_ID_UNSET;
-	auto* header = (L2HeaderSH*) headers.at(0);
-	return header->src_id;
+	return visit(*headers.at(0), OriginVisitor());
 }
 
 void L2Packet::addCallback(L2PacketSentCallback* callback) {
@@ -93,8 +333,7 @@ void L2Packet::addCallback(L2PacketSentCallback* callback) {
 void L2Packet::validateHeader() const {
 	if (headers.empty())
 		throw std::logic_error("No headers present.");
-	const L2Header* first_header = headers.at(0);
-	if (first_header->frame_type != L2Header::base)
+	if (descriptors.at(0).frame_type != L2Header::base)
 		throw std::runtime_error("First header is not a base header.");
 }
 
@@ -106,8 +345,8 @@ void L2Packet::notifyCallbacks() {
 std::string L2Packet::print() {
 	std::string result = "[ ";
 	for (int i = 0; i < headers.size(); i++) {
-	    auto headerType = headers[i]->frame_type;
-	    int size = (int)headers[i]->getBits();
+	    auto headerType = descriptors[i].frame_type;
+	    int size = (int)getHeaderBits(i);
 	    if (headerType == L2Header::FrameType::broadcast) {
             result += "BC(" + std::to_string(size) + "),";
 	    }
@@ -162,27 +401,31 @@ std::string L2Packet::print() {
 void L2Packet::erase(size_t index) {
 	if (index >= this->headers.size() || index >= this->payloads.size())
 		throw std::invalid_argument("L2Packet::erase for index out of bounds.");
-	delete headers.at(index);	
+	removeFromTotals(index);
+	if (headers.at(index) != nullptr)
+		headers.at(index)->setSizeObserver(nullptr);
+	release(headers.at(index));
 	this->headers.erase(this->headers.begin() + index);
-	delete payloads.at(index);
+	release(payloads.at(index));
 	this->payloads.erase(this->payloads.begin() + index);
+	this->descriptors.erase(this->descriptors.begin() + index);
 }
 
 bool L2Packet::isDME() const {
 	if (getOrigin() == SYMBOLIC_LINK_ID_DME)
 		return true;
-	for (auto *header : this->headers)
-		if (header->isDMERequest() || header->isDMEResponse())
+	for (const auto& descriptor : this->descriptors)
+		if (descriptor.frame_type == L2Header::dme_request || descriptor.frame_type == L2Header::dme_response)
 			return true;
 	return false;
 }
 
 bool L2Packet::empty() const {
-	if (this->payloads.empty())
-		return true;
-	size_t payload_size = 0;
-	for (const auto *payload : payloads)
-		if (payload != nullptr)
-			payload_size += payload->getBits();
-	return payload_size == 0;
-}
\ No newline at end of file
+	describePayloads();
+	if (fixed_payload_total > 0)
+		return false;
+	for (size_t index : variable_payloads)
+		if (payloads[index]->getBits() > 0)
+			return false;
+	return true;
+}
@@ -18,7 +18,9 @@
 #define INTAIRNET_LINKLAYER_GLUE_L2PACKET_HPP
 
 #include "L2Header.hpp"
+#include "SlotArena.hpp"
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -40,7 +42,7 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 	 * It keeps a pointer to the original packet and adds functionality specific to the MC-SOTDMA protocol.
 	 * When MC-SOTDMA operation finishes, the original packet is passed on to the respective receiving layer.
 	 */
-	class L2Packet {
+	class L2Packet : public ArenaObject, protected SizeObserver {
 
 		friend class LinkManagerTests;
 
@@ -48,26 +50,74 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		/**
 		 * Interface for a wrapper of an upper-layer packet.
 		*/
-		class Payload {
+		class Payload : public ArenaObject {
 		public:
 			virtual unsigned int getBits() const = 0;
 
 			virtual ~Payload() = default;
 
 			virtual Payload* copy() const = 0;
+
+			/**
+			 * @return Whether getBits() stays the same once this payload was added to a packet, s.t. the packet can keep it in its running total.
+			 * Payloads that can be resized afterwards (e.g. InetPacketPayload) return false and are queried on demand.
+			 */
+			virtual bool hasFixedBits() const {
+				return true;
+			}
 		};
 
 		L2Packet();
 
-		L2Packet(const L2Packet& other);
+		/**
+		 * Deletes a packet unless it belongs to an arena, which destroys it upon reset.
+		 * Layers that dispose of packets they were handed must use this instead of delete, s.t. packets may come from a SlotArena.
+		 * @param packet May be nullptr.
+		 */
+		static void destroy(L2Packet* packet);
+
+		/** Disposes of packets through destroy(), e.g. for std::unique_ptr. */
+		struct Deleter {
+			void operator()(L2Packet* packet) const {
+				destroy(packet);
+			}
+		};
+
+		/**
+		 * Packets own their headers and payloads, so they cannot be copied implicitly. Use clone() or copy() for deep copies.
+		 */
+		L2Packet(const L2Packet& other) = delete;
+
+		L2Packet& operator=(const L2Packet& other) = delete;
+
+		/**
+		 * Takes over all headers, payloads and callbacks from 'other', which is left empty. This packet itself is on the heap.
+		 * @param other
+		 */
+		L2Packet(L2Packet&& other) noexcept;
+
+		/**
+		 * Releases this packet's headers and payloads, then takes over everything from 'other', which is left empty.
+		 * @param other
+		 * @return This packet.
+		 */
+		L2Packet& operator=(L2Packet&& other) noexcept;
 
+		/**
+		 * @return A deep copy on the heap that the caller owns.
+		 */
 		L2Packet* copy() const;
 
+		/**
+		 * @return A deep copy on the heap.
+		 */
+		std::unique_ptr<L2Packet> clone() const;
+
 		virtual ~L2Packet();
 
 		/**
 		 * Add a (header, payload)-pair.
-		 * These will be deleted by this L2Packet's destructor.
+		 * These will be deleted by this L2Packet's destructor, unless they belong to an arena.
 		 * @param header
 		 * @param payload
 		 */
@@ -76,17 +126,66 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		void addMessage(std::pair<L2Header*, Payload*> message);
 
 		/**
+		 * Add a (header, payload)-pair, taking ownership of both.
+		 * @param header
+		 * @param payload May be empty.
+		 */
+		void addMessage(std::unique_ptr<L2Header> header, std::unique_ptr<Payload> payload);
+
+		/**
+		 * Removes the (header, payload)-pair at the given index and hands its ownership to the caller.
+		 * Messages that belong to an arena are copied onto the heap instead, as the arena will destroy the originals.
+		 * @param index
+		 * @return The removed header and payload; the payload may be empty.
+		 * @throws std::invalid_argument If the index is out of bounds.
+		 */
+		std::pair<std::unique_ptr<L2Header>, std::unique_ptr<Payload>> releaseMessage(size_t index);
+
+		/**
+		 * Compact per-message summary that is captured when a message is added, so that hot queries can scan contiguous memory instead of calling into every header and payload.
+		 */
+		struct MessageDescriptor {
+			/** Frame type of the header, which cannot change after construction. */
+			L2Header::FrameType frame_type = L2Header::FrameType::unset;
+			/** Whether a header is present at all. */
+			bool has_header = false;
+			/** Whether the header's size is fixed. The size of a variable-sized header (L2HeaderSH) is queried on demand. */
+			bool fixed_header_bits = true;
+			/** Size of a fixed-size header. */
+			unsigned int header_bits = 0;
+			/** Whether a payload is present. */
+			bool has_payload = false;
+			/** Whether the payload's size is fixed, see Payload::hasFixedBits(). The size of a variable-sized payload is queried on demand. */
+			bool fixed_payload_bits = true;
+			/** Size of a fixed-size payload. */
+			unsigned int payload_bits = 0;
+		};
+
+		/**
+		 * Entries may be replaced through the returned reference, which makes the next size query describe all payloads anew.
+		 * Keep the number of entries as is; use addMessage() and erase() for that. Call this again for changes after such a query.
 		 * @return All payloads.
 		 */
 		std::vector<Payload*>& getPayloads();
 
+		const std::vector<Payload*>& getPayloads() const;
+
 		/**
 		 * @return All headers.
 		 */
 		const std::vector<L2Header*>& getHeaders();		
 
+		const std::vector<L2Header*>& getHeaders() const;
+
+		/**
+		 * @return One descriptor per (header, payload)-pair, in the same order as getHeaders() and getPayloads().
+		 */
+		const std::vector<MessageDescriptor>& getDescriptors() const;
+
 		/**
 		 * @return Total size of this packet in bits, consisting of both headers and payloads.
+		 * The total of all headers and fixed-size payloads is maintained as messages are added and erased, and only recomputed after a contained header reported a size change.
+		 * Only payloads without a fixed size are queried on every call.
 		 */
 		unsigned int getBits() const;
 
@@ -139,17 +238,19 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		void erase(size_t index);
 
 		/**
-		 * Flag that indicates whether an error was introduced by transmitting over the channel
+		 * Flag that indicates whether an error was introduced by transmitting over the channel.
+		 * Per-receiver fields are only meaningful on a packet that a single receiver owns, e.g. after L2PacketReception::release() wrote them.
+		 * A packet that receivers share never carries them; each reception's ReceptionDescriptor does, see IMac::receiveSharedFromLower().
 		 */
 		bool hasChannelError = false;
 
 		/**
-		 * Distance from the sender at which the packet was received. Intended to calculate SINR. 
+		 * Distance from the sender at which the packet was received. Intended to calculate SINR. See hasChannelError for shared packets.
 		 */
 		double receptionDist = 0.0;
 
 		/**
-		 * SNR when the packet is received
+		 * SNR when the packet is received. See hasChannelError for shared packets.
 		 */
 		double snr = 0.0;
 
@@ -165,6 +266,37 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 */
 		void validateHeader() const;
 
+		/** Deletes a header or payload unless it belongs to an arena. */
+		template <typename T>
+		void release(T* message) const;
+
+		/** Deletes all headers and payloads, see release(). */
+		void releaseAll();
+
+		/** @return The descriptor for a message that is about to be added. */
+		static MessageDescriptor describe(const L2Header* header, const Payload* payload);
+
+		/** @return The size of the header at the given index. */
+		unsigned int getHeaderBits(size_t index) const;
+
+		/** @return The size of the message at the given index that counts towards the cached total: its header and fixed-size payload, or zero if it has no header. */
+		unsigned int getCountedBits(size_t index) const;
+
+		/** Adds the last message to the running totals. */
+		void addToTotals();
+
+		/** Removes the message at the given index from the running totals, before it is erased. */
+		void removeFromTotals(size_t index);
+
+		/** Invalidates the cached size, as a contained header has changed its size. */
+		void onSizeChanged() override;
+
+		/** Registers this packet as the size observer of all its headers. */
+		void observeHeaders();
+
+		/** Captures the payloads' descriptors and totals anew if they may have been replaced through getPayloads(). */
+		void describePayloads() const;
+
 	protected:
 		/** Several headers can be concatenated to fill one packet. */
 		std::vector<L2Header*> headers;
@@ -172,6 +304,22 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		/** Several payloads can be concatenated (with resp. headers) to fill one packet. */
 		std::vector<Payload*> payloads;
 
+		/** Parallel to 'headers' and 'payloads'. Mutable, s.t. const queries can call describePayloads(). */
+		mutable std::vector<MessageDescriptor> descriptors;
+
+		/** Cached total size of all headers and fixed-size payloads, see getBits(). */
+		mutable unsigned int bits = 0;
+		mutable bool bits_valid = true;
+
+		/** Total size of all fixed-size payloads, including those without a header, see empty(). */
+		mutable unsigned int fixed_payload_total = 0;
+
+		/** Ascending indices of the messages whose payload size is queried on demand. */
+		mutable std::vector<size_t> variable_payloads;
+
+		/** Set by the non-const getPayloads(), see describePayloads(). */
+		mutable bool payloads_changed = false;
+
 		/** Holds all registered callbacks. */
 		std::vector<L2PacketSentCallback*> callbacks;
 	};
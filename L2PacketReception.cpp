@@ -0,0 +1,85 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "L2PacketReception.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+L2PacketReception::L2PacketReception(L2Packet* packet) : shared_packet(nullptr) {
+	if (packet == nullptr)
+		throw std::invalid_argument("L2PacketReception for nullptr packet.");
+	shared_packet = new SharedPacket(packet);
+}
+
+L2PacketReception::L2PacketReception(const L2PacketReception& other) : descriptor(other.descriptor), shared_packet(other.shared_packet) {
+	// A new reference can only be taken from an existing one, so the count can't drop to zero meanwhile.
+	if (shared_packet != nullptr)
+		shared_packet->num_references.fetch_add(1, std::memory_order_relaxed);
+}
+
+L2PacketReception& L2PacketReception::operator=(L2PacketReception other) noexcept {
+	descriptor = other.descriptor;
+	std::swap(shared_packet, other.shared_packet);
+	return *this;
+}
+
+void L2PacketReception::detach() {
+	if (shared_packet == nullptr)
+		return;
+	// acq_rel: the last reception sees all other receptions' reads of the packet before it deletes or takes it.
+	if (shared_packet->num_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		delete shared_packet;
+	shared_packet = nullptr;
+}
+
+const L2Packet& L2PacketReception::getPacket() const {
+	if (shared_packet == nullptr)
+		throw std::logic_error("L2PacketReception::getPacket for a released reception.");
+	return *shared_packet->packet;
+}
+
+L2Packet& L2PacketReception::getMutablePacket() {
+	if (shared_packet == nullptr)
+		throw std::logic_error("L2PacketReception::getMutablePacket for a released reception.");
+	if (isShared()) {
+		auto* copy = new SharedPacket(shared_packet->packet->copy());
+		detach();
+		shared_packet = copy;
+	}
+	return *shared_packet->packet;
+}
+
+bool L2PacketReception::isShared() const {
+	return shared_packet != nullptr && shared_packet->num_references.load(std::memory_order_acquire) > 1;
+}
+
+L2Packet* L2PacketReception::release() {
+	if (shared_packet == nullptr)
+		throw std::logic_error("L2PacketReception::release for a released reception.");
+	// Copy while this reception's reference still keeps the packet alive and unmodified by others.
+	L2Packet* packet = isShared() ? shared_packet->packet->copy() : nullptr;
+	// Only the reception whose decrement returns 1 owns the packet. If the others let go meanwhile, the copy is used and the original deleted.
+	if (shared_packet->num_references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		if (packet == nullptr)
+			packet = shared_packet->packet.release();
+		delete shared_packet;
+	}
+	shared_packet = nullptr;
+	packet->hasChannelError = descriptor.hasChannelError;
+	packet->receptionDist = descriptor.receptionDist;
+	packet->snr = descriptor.snr;
+	return packet;
+}
@@ -0,0 +1,115 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_L2PACKETRECEPTION_HPP
+#define INTAIRNET_LINKLAYER_GLUE_L2PACKETRECEPTION_HPP
+
+#include <atomic>
+#include <memory>
+#include "L2Packet.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Properties of a packet that differ per receiver.
+	 */
+	class ReceptionDescriptor {
+	public:
+		/** Whether an error was introduced by transmitting over the channel. */
+		bool hasChannelError = false;
+		/** Distance from the sender at which the packet was received. */
+		double receptionDist = 0.0;
+		/** SNR when the packet is received. */
+		double snr = 0.0;
+	};
+
+	/**
+	 * One receiver's view of a transmitted packet.
+	 * Copies of a reception share the same immutable packet, so that a broadcast can be handed to all receivers without copying it.
+	 * Each copy has its own ReceptionDescriptor, and modifying the packet itself copies it first if it's still shared (copy-on-write).
+	 * Different copies may be used by different threads.
+	 */
+	class L2PacketReception {
+	public:
+		/**
+		 * @param packet A packet, which this reception takes ownership of and disposes of through L2Packet::destroy().
+		 */
+		explicit L2PacketReception(L2Packet* packet);
+
+		L2PacketReception(const L2PacketReception& other);
+
+		/** Inline, as receptions are moved up through every layer of the stack. */
+		L2PacketReception(L2PacketReception&& other) noexcept : descriptor(other.descriptor), shared_packet(other.shared_packet) {
+			other.shared_packet = nullptr;
+		}
+
+		L2PacketReception& operator=(L2PacketReception other) noexcept;
+
+		~L2PacketReception() {
+			// Moved-from receptions have nothing to drop.
+			if (shared_packet != nullptr)
+				detach();
+		}
+
+		/**
+		 * @return The shared packet for read-only access.
+		 */
+		const L2Packet& getPacket() const;
+
+		/**
+		 * Copies the packet if it's shared with other receptions, s.t. changes don't affect them.
+		 * @return A packet that only this reception refers to.
+		 */
+		L2Packet& getMutablePacket();
+
+		/**
+		 * @return Whether other receptions refer to the same packet.
+		 */
+		bool isShared() const;
+
+		/**
+		 * Hands the packet over to interfaces that take ownership of a raw L2Packet*.
+		 * It is copied only if other receptions still refer to it, and the descriptor is written into the packet's per-receiver fields.
+		 * Afterwards, this reception is empty.
+		 * @return A packet the caller owns.
+		 */
+		L2Packet* release();
+
+		/** This receiver's properties of the reception. */
+		ReceptionDescriptor descriptor;
+
+	protected:
+		/**
+		 * The packet together with the number of receptions referring to it.
+		 */
+		struct SharedPacket {
+			explicit SharedPacket(L2Packet* packet) : packet(packet) {}
+
+			std::unique_ptr<L2Packet, L2Packet::Deleter> packet;
+			std::atomic<size_t> num_references = {1};
+		};
+
+		/**
+		 * Drops this reception's reference, deleting the shared packet if it was the last one.
+		 */
+		void detach();
+
+		/** The last reception referring to the packet may take it out of the holder instead of copying it. Packets from an arena are left to it. */
+		SharedPacket* shared_packet;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_L2PACKETRECEPTION_HPP
@@ -0,0 +1,130 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "NeighborPositionTable.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+const int32_t NeighborPositionTable::EMPTY_SLOT;
+
+size_t NeighborPositionTable::getHomeSlot(int id) const {
+	// Fibonacci hashing spreads consecutive IDs over the table.
+	const uint64_t hash = uint64_t(uint32_t(id)) * 0x9E3779B97F4A7C15ull;
+	return size_t(hash >> 32) & (slots.size() - 1);
+}
+
+size_t NeighborPositionTable::probe(int id) const {
+	size_t slot = getHomeSlot(id);
+	while (slots[slot] != EMPTY_SLOT && entries[slots[slot]].id != id)
+		slot = (slot + 1) & (slots.size() - 1);
+	return slot;
+}
+
+void NeighborPositionTable::rehash(size_t num_slots) {
+	slots.assign(num_slots, EMPTY_SLOT);
+	for (size_t i = 0; i < entries.size(); i++)
+		slots[probe(entries[i].id)] = (int32_t) i;
+}
+
+NeighborPositionTable::Entry& NeighborPositionTable::update(const MacId& id, const CPRPosition& position, CPRPosition::PositionQuality quality) {
+	if (2 * (entries.size() + 1) > slots.size())
+		rehash(slots.empty() ? 16 : 2 * slots.size());
+	const size_t slot = probe(id.getId());
+	if (slots[slot] != EMPTY_SLOT) {
+		Entry& entry = entries[slots[slot]];
+		entry.position = position;
+		entry.quality = quality;
+		return entry;
+	}
+	slots[slot] = (int32_t) entries.size();
+	entries.emplace_back(id.getId(), position, quality);
+	return entries.back();
+}
+
+const NeighborPositionTable::Entry* NeighborPositionTable::find(const MacId& id) const {
+	if (entries.empty())
+		return nullptr;
+	const size_t slot = probe(id.getId());
+	return slots[slot] == EMPTY_SLOT ? nullptr : &entries[slots[slot]];
+}
+
+NeighborPositionTable::Entry* NeighborPositionTable::find(const MacId& id) {
+	return const_cast<Entry*>(static_cast<const NeighborPositionTable*>(this)->find(id));
+}
+
+bool NeighborPositionTable::contains(const MacId& id) const {
+	return find(id) != nullptr;
+}
+
+bool NeighborPositionTable::erase(const MacId& id) {
+	if (entries.empty())
+		return false;
+	size_t slot = probe(id.getId());
+	if (slots[slot] == EMPTY_SLOT)
+		return false;
+	// Move the last entry into the erased one's place and point its slot there.
+	const int32_t index = slots[slot];
+	const int32_t last = (int32_t) entries.size() - 1;
+	if (index != last) {
+		slots[probe(entries[last].id)] = index;
+		entries[index] = entries[last];
+	}
+	entries.pop_back();
+	// Backward-shift deletion keeps every remaining ID reachable from its home slot without tombstones.
+	const size_t mask = slots.size() - 1;
+	size_t next = (slot + 1) & mask;
+	while (slots[next] != EMPTY_SLOT) {
+		const size_t home = getHomeSlot(entries[slots[next]].id);
+		// Shift back if the home slot doesn't lie cyclically within (slot, next].
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			slots[slot] = slots[next];
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+	slots[slot] = EMPTY_SLOT;
+	return true;
+}
+
+void NeighborPositionTable::clear() {
+	entries.clear();
+	slots.clear();
+}
+
+void NeighborPositionTable::reserve(size_t num_neighbors) {
+	entries.reserve(num_neighbors);
+	size_t num_slots = slots.empty() ? 16 : slots.size();
+	while (num_slots < 2 * num_neighbors)
+		num_slots *= 2;
+	if (num_slots != slots.size())
+		rehash(num_slots);
+}
+
+size_t NeighborPositionTable::size() const {
+	return entries.size();
+}
+
+bool NeighborPositionTable::empty() const {
+	return entries.empty();
+}
+
+const NeighborPositionTable::Entry* NeighborPositionTable::begin() const {
+	return entries.data();
+}
+
+const NeighborPositionTable::Entry* NeighborPositionTable::end() const {
+	return entries.data() + entries.size();
+}
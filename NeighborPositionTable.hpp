@@ -0,0 +1,109 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_NEIGHBORPOSITIONTABLE_HPP
+#define INTAIRNET_LINKLAYER_GLUE_NEIGHBORPOSITIONTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MacId.hpp"
+#include "CPRPosition.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Holds the latest known position and position quality of each neighbor.
+	 * Entries are stored contiguously and are found through an open-addressing index keyed by MacId::getId(),
+	 * so that lookups and updates take constant time and iterating over all neighbors scans a single array.
+	 * Pointers and references to entries are invalidated by update() calls for new IDs and by erase().
+	 */
+	class NeighborPositionTable {
+	public:
+		struct Entry {
+			Entry(int id, const CPRPosition& position, CPRPosition::PositionQuality quality) : id(id), position(position), quality(quality) {}
+
+			MacId getMacId() const {
+				return MacId(id);
+			}
+
+			int id;
+			CPRPosition position;
+			CPRPosition::PositionQuality quality;
+		};
+
+		/**
+		 * Inserts the neighbor or overwrites its current entry.
+		 * @param id
+		 * @param position
+		 * @param quality
+		 * @return The neighbor's entry.
+		 */
+		Entry& update(const MacId& id, const CPRPosition& position, CPRPosition::PositionQuality quality);
+
+		/**
+		 * @param id
+		 * @return The neighbor's entry, or nullptr if it is unknown.
+		 */
+		const Entry* find(const MacId& id) const;
+
+		Entry* find(const MacId& id);
+
+		bool contains(const MacId& id) const;
+
+		/**
+		 * Removes a neighbor. The last entry takes its place.
+		 * @param id
+		 * @return Whether the neighbor was known.
+		 */
+		bool erase(const MacId& id);
+
+		void clear();
+
+		/** Reserves space for 'num_neighbors' entries, so that adding them doesn't reallocate. */
+		void reserve(size_t num_neighbors);
+
+		size_t size() const;
+
+		bool empty() const;
+
+		const Entry* begin() const;
+
+		const Entry* end() const;
+
+	protected:
+		/** @return Index into 'slots' where the search for 'id' starts. */
+		size_t getHomeSlot(int id) const;
+
+		/** @return Index into 'slots' that holds 'id', or the empty slot where it would be inserted. */
+		size_t probe(int id) const;
+
+		/** Rebuilds the index with 'num_slots' slots, which must be a power of two. */
+		void rehash(size_t num_slots);
+
+	protected:
+		/** Marks an unused slot. */
+		static const int32_t EMPTY_SLOT = -1;
+
+		/** Dense storage of all entries. */
+		std::vector<Entry> entries;
+
+		/** Open-addressing index with linear probing. Each slot holds an index into 'entries' or EMPTY_SLOT. At most half of the slots are used. */
+		std::vector<int32_t> slots;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_NEIGHBORPOSITIONTABLE_HPP
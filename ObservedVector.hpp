@@ -0,0 +1,350 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_OBSERVEDVECTOR_HPP
+#define INTAIRNET_LINKLAYER_GLUE_OBSERVEDVECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Is notified whenever the number of elements of an observed container changes.
+	 */
+	class SizeObserver {
+	public:
+		virtual ~SizeObserver() = default;
+
+		virtual void onSizeChanged() = 0;
+	};
+
+	/**
+	 * A sequence container with the std::vector interface the headers need, which notifies its observer whenever elements are added or removed.
+	 * Headers whose size depends on the number of contained elements use it so that cached sizes can be invalidated.
+	 * Modifying an element in place does not notify, as it doesn't change the number of elements.
+	 * The first N elements are stored inline, so that constructing or copying a header doesn't allocate.
+	 * It converts from and to std::vector for code that works with the plain container.
+	 * @tparam T Element type.
+	 * @tparam N Inline capacity.
+	 * @tparam growable Whether more than N elements may be added, which moves them to the heap. Otherwise, N is the maximum size, e.g. set by a protocol field's width.
+	 */
+	template <typename T, size_t N, bool growable = false>
+	class ObservedVector {
+	public:
+		typedef T value_type;
+		typedef size_t size_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+
+		ObservedVector() = default;
+
+		/**
+		 * @param observer Notified when the number of elements changes. May be nullptr.
+		 */
+		explicit ObservedVector(SizeObserver* observer) : observer(observer) {}
+
+		/** The observer is not copied, as it belongs to the owner of 'other'. */
+		ObservedVector(const ObservedVector& other) {
+			append(other.begin(), other.end());
+		}
+
+		/** @throws std::length_error If 'elements' exceed the capacity of a fixed-size container. */
+		ObservedVector(const std::vector<T>& elements) {
+			append(elements.begin(), elements.end());
+		}
+
+		/** Copies the elements, but keeps this container's observer. */
+		ObservedVector& operator=(const ObservedVector& other) {
+			if (this != &other)
+				assign(other.begin(), other.end());
+			return *this;
+		}
+
+		/** @throws std::length_error If 'elements' exceed the capacity of a fixed-size container. */
+		ObservedVector& operator=(const std::vector<T>& elements) {
+			assign(elements.begin(), elements.end());
+			return *this;
+		}
+
+		~ObservedVector() {
+			destroy(0);
+			if (!isInline())
+				::operator delete(elements);
+		}
+
+		operator std::vector<T>() const {
+			return std::vector<T>(begin(), end());
+		}
+
+		size_t capacity() const {
+			return elements_capacity;
+		}
+
+		static constexpr size_t max_size() {
+			return growable ? std::numeric_limits<size_t>::max() / sizeof(T) : N;
+		}
+
+		size_t size() const {
+			return num_elements;
+		}
+
+		bool empty() const {
+			return num_elements == 0;
+		}
+
+		/**
+		 * @param capacity
+		 * @throws std::length_error If 'capacity' exceeds N for a fixed-size container.
+		 */
+		void reserve(size_t capacity) {
+			grow(capacity);
+		}
+
+		T* data() {
+			return elements;
+		}
+
+		const T* data() const {
+			return elements;
+		}
+
+		T& at(size_t index) {
+			checkIndex(index);
+			return data()[index];
+		}
+
+		const T& at(size_t index) const {
+			checkIndex(index);
+			return data()[index];
+		}
+
+		T& operator[](size_t index) {
+			return data()[index];
+		}
+
+		const T& operator[](size_t index) const {
+			return data()[index];
+		}
+
+		T& front() {
+			return data()[0];
+		}
+
+		const T& front() const {
+			return data()[0];
+		}
+
+		T& back() {
+			return data()[num_elements - 1];
+		}
+
+		const T& back() const {
+			return data()[num_elements - 1];
+		}
+
+		iterator begin() {
+			return data();
+		}
+
+		const_iterator begin() const {
+			return data();
+		}
+
+		iterator end() {
+			return data() + num_elements;
+		}
+
+		const_iterator end() const {
+			return data() + num_elements;
+		}
+
+		/** @throws std::length_error If a fixed-size container is full. */
+		void push_back(const T& element) {
+			emplace_back(element);
+		}
+
+		/** @throws std::length_error If a fixed-size container is full. */
+		template <typename... Args>
+		void emplace_back(Args&&... args) {
+			if (num_elements == elements_capacity) {
+				// Construct first, as 'args' may refer to an element that is about to be moved.
+				T value = T(std::forward<Args>(args)...);
+				grow(num_elements + 1);
+				new (data() + num_elements) T(std::move(value));
+			} else
+				new (data() + num_elements) T(std::forward<Args>(args)...);
+			num_elements++;
+			notify();
+		}
+
+		/**
+		 * Replaces all elements by copies of [first, last).
+		 * @throws std::length_error If the range exceeds the capacity of a fixed-size container, which is then left unchanged.
+		 */
+		template <typename ForwardIterator>
+		void assign(ForwardIterator first, ForwardIterator last) {
+			const auto num_assigned = (size_t) std::distance(first, last);
+			checkCapacity(num_assigned);
+			destroy(0);
+			append(first, last);
+			notify();
+		}
+
+		void pop_back() {
+			destroy(num_elements - 1);
+			notify();
+		}
+
+		/** @throws std::length_error If a fixed-size container is full. */
+		iterator insert(const_iterator position, const T& element) {
+			const size_t index = position - begin();
+			// Copy first, as 'element' may refer to an element that is about to be moved.
+			T value = element;
+			grow(num_elements + 1);
+			if (index == num_elements)
+				new (data() + num_elements) T(std::move(value));
+			else {
+				new (data() + num_elements) T(std::move(data()[num_elements - 1]));
+				for (size_t i = num_elements - 1; i > index; i--)
+					data()[i] = std::move(data()[i - 1]);
+				data()[index] = std::move(value);
+			}
+			num_elements++;
+			notify();
+			return data() + index;
+		}
+
+		iterator erase(const_iterator position) {
+			return erase(position, position + 1);
+		}
+
+		iterator erase(const_iterator first, const_iterator last) {
+			const size_t index = first - begin(), num_erased = last - first;
+			if (num_erased > 0) {
+				for (size_t i = index; i + num_erased < num_elements; i++)
+					data()[i] = std::move(data()[i + num_erased]);
+				destroy(num_elements - num_erased);
+				notify();
+			}
+			return data() + index;
+		}
+
+		/** @throws std::length_error If 'size' exceeds N for a fixed-size container. */
+		void resize(size_t size) {
+			grow(size);
+			if (size == num_elements)
+				return;
+			if (size < num_elements)
+				destroy(size);
+			else
+				for (; num_elements < size; num_elements++)
+					new (data() + num_elements) T();
+			notify();
+		}
+
+		void clear() {
+			destroy(0);
+			notify();
+		}
+
+		bool operator==(const ObservedVector& other) const {
+			return num_elements == other.num_elements && std::equal(begin(), end(), other.begin());
+		}
+
+		bool operator!=(const ObservedVector& other) const {
+			return !(*this == other);
+		}
+
+	protected:
+		void notify() {
+			if (observer != nullptr)
+				observer->onSizeChanged();
+		}
+
+		/** Destroys all elements from 'index' on, without notifying. */
+		void destroy(size_t index) {
+			for (; num_elements > index; num_elements--)
+				data()[num_elements - 1].~T();
+		}
+
+		bool isInline() const {
+			return elements == reinterpret_cast<const T*>(storage);
+		}
+
+		/** Copies [first, last) to the end, without notifying. */
+		template <typename ForwardIterator>
+		void append(ForwardIterator first, ForwardIterator last) {
+			grow(num_elements + (size_t) std::distance(first, last));
+			for (; first != last; ++first) {
+				new (data() + num_elements) T(*first);
+				num_elements++;
+			}
+		}
+
+		/**
+		 * Makes room for 'size' elements, moving them to the heap if a growable container outgrows its storage.
+		 * @throws std::length_error If 'size' exceeds N for a fixed-size container.
+		 */
+		void grow(size_t size) {
+			if (size <= elements_capacity)
+				return;
+			checkCapacity(size);
+			const size_t grown_capacity = std::max(size, 2 * elements_capacity);
+			T* grown = static_cast<T*>(::operator new(grown_capacity * sizeof(T)));
+			for (size_t i = 0; i < num_elements; i++) {
+				new (grown + i) T(std::move(elements[i]));
+				elements[i].~T();
+			}
+			if (!isInline())
+				::operator delete(elements);
+			elements = grown;
+			elements_capacity = grown_capacity;
+		}
+
+		void checkCapacity(size_t size) const {
+			if (growable)
+				return;
+			if (size > N)
+				throw std::length_error("ObservedVector exceeds its capacity of " + std::to_string(N) + " elements.");
+		}
+
+		void checkIndex(size_t index) const {
+			if (index >= num_elements)
+				throw std::out_of_range("ObservedVector::at for index " + std::to_string(index) + " with size " + std::to_string(num_elements) + ".");
+		}
+
+	protected:
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[N];
+		/** Points to 'storage' until a growable container outgrows it. */
+		T* elements = reinterpret_cast<T*>(storage);
+		size_t elements_capacity = N;
+		size_t num_elements = 0;
+		SizeObserver* observer = nullptr;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_OBSERVEDVECTOR_HPP
@@ -22,13 +22,15 @@
 using namespace TUHH_INTAIRNET_MCSOTDMA;
 
 void PassThroughArq::notifyOutgoing(unsigned int num_bits, const MacId& mac_id) {
-	debug("PassThroughArq::notifyOutgoing " + std::to_string(num_bits));
+	if (isDebugEnabled())
+		debug("PassThroughArq::notifyOutgoing " + std::to_string(num_bits));
 	IMac* mac = getLowerLayer();
 	mac->notifyOutgoing(num_bits, mac_id);
 }
 
 L2Packet* PassThroughArq::requestSegment(unsigned int num_bits, const MacId& mac_id) {
-	debug("PassThroughArq::requestSegment " + std::to_string(num_bits));
+	if (isDebugEnabled())
+		debug("PassThroughArq::requestSegment " + std::to_string(num_bits));
 	IRlc* rlc = getUpperLayer();
 	return rlc->requestSegment(num_bits, mac_id);
 }
@@ -38,17 +40,26 @@ bool PassThroughArq::shouldLinkBeArqProtected(const MacId& mac_id) const {
 }
 
 void PassThroughArq::injectIntoUpper(L2Packet* packet) {
-	debug("PassThroughArq::injectIntoUpper");
+	if (isDebugEnabled())
+		debug("PassThroughArq::injectIntoUpper");
 	IRlc* rlc = getUpperLayer();
 	return rlc->receiveInjectionFromLower(packet);
 }
 
 void PassThroughArq::receiveFromLower(L2Packet* packet) {
-	debug("PassThroughArq::receiveFromLower");
+	if (isDebugEnabled())
+		debug("PassThroughArq::receiveFromLower");
 	IRlc* rlc = getUpperLayer();
 	return rlc->receiveFromLower(packet);
 }
 
+void PassThroughArq::receiveSharedFromLower(L2PacketReception reception) {
+	if (isDebugEnabled())
+		debug("PassThroughArq::receiveSharedFromLower");
+	IRlc* rlc = getUpperLayer();
+	rlc->receiveSharedFromLower(std::move(reception));
+}
+
 void PassThroughArq::notifyAboutNewLink(const MacId& id) {
 	return;
 }
@@ -58,9 +69,10 @@ void PassThroughArq::notifyAboutRemovedLink(const MacId& id) {
 }
 
 void PassThroughArq::processIncomingHeader(L2Packet* incoming_packet) {
+	// No ARQ state to update; receiveFromLower() passes packets straight on.
 	return;
 }
 
 void PassThroughArq::onEvent(double time) {
-
+	flushEmissions();
 }
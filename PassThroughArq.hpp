@@ -34,6 +34,8 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 
 		void receiveFromLower(L2Packet* packet) override;
 
+		void receiveSharedFromLower(L2PacketReception reception) override;
+
 		void notifyAboutNewLink(const MacId& id) override;
 
 		void notifyAboutRemovedLink(const MacId& id) override;
@@ -22,37 +22,65 @@
 using namespace TUHH_INTAIRNET_MCSOTDMA;
 
 
+PassThroughRlc::~PassThroughRlc() {
+	for (L3Packet* packet : networkLayerPackets)
+		deletePacket(packet);
+}
+
 void PassThroughRlc::init() {
 	double time = getTime() + 1;
-	debug("TEST " + std::to_string(time));
+	if (isDebugEnabled())
+		debug("TEST " + std::to_string(time));
 	emit("x", 1.0);
 
 }
 
 void PassThroughRlc::onEvent(double time) {
-
+	flushEmissions();
 }
 
 void PassThroughRlc::receiveFromUpper(L3Packet* data, MacId dest, PacketPriority priority) {
 	networkLayerPackets.push_back(data);
-	emit("rlc_nw_queue", size_t(100));
-	debug("rlc_nw_queue");
+	emit("rlc_nw_queue", size_t(bits_per_packet));
+	if (isDebugEnabled())
+		debug("rlc_nw_queue");
 	IArq* arq = getLowerLayer();
-	arq->notifyOutgoing(100, dest);
+	arq->notifyOutgoing(bits_per_packet, dest);
 
 }
 
 void PassThroughRlc::receiveFromLower(L2Packet* packet) {
-	linkLayerPackets.push_back(packet);
+	num_received++;
+	L2Packet::destroy(packet);
 
 }
 
+void PassThroughRlc::receiveSharedFromLower(L2PacketReception) {
+	num_received++;
+}
+
 void PassThroughRlc::receiveInjectionFromLower(L2Packet* packet, PacketPriority priority) {
 
 }
 
 L2Packet* PassThroughRlc::requestSegment(unsigned int num_bits, const MacId& mac_id) {
+	if (!networkLayerPackets.empty()) {
+		deletePacket(networkLayerPackets.front());
+		networkLayerPackets.pop_front();
+	}
 	auto packet = new L2Packet();
 	return packet;
 }
 
+bool PassThroughRlc::isThereMoreData(const MacId& mac_id) const {
+	return !networkLayerPackets.empty();
+}
+
+unsigned int PassThroughRlc::getQueuedDataSize(MacId dest) {
+	return (unsigned int) networkLayerPackets.size() * bits_per_packet;
+}
+
+size_t PassThroughRlc::getNumReceived() const {
+	return num_received;
+}
+
@@ -26,17 +26,38 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 	class PassThroughRlc : public IRlc, public IOmnetPluggable {
 
 	private:
+		/** Number of bits announced to the lower layer per network-layer packet. */
+		static constexpr unsigned int bits_per_packet = 100;
 		std::deque<L3Packet*> networkLayerPackets;
-		std::deque<L2Packet*> linkLayerPackets;
+		size_t num_received = 0;
 	public:
+		/** Hands queued network-layer packets back through deletePacket(). */
+		~PassThroughRlc();
+
 		void receiveFromUpper(L3Packet* data, MacId dest, PacketPriority priority = PRIORITY_DEFAULT) override;
 
 		void receiveFromLower(L2Packet* packet) override;
 
+		/** Counts the packet, which it doesn't need to copy. */
+		void receiveSharedFromLower(L2PacketReception reception) override;
+
 		void receiveInjectionFromLower(L2Packet* packet, PacketPriority priority = PRIORITY_LINK_MANAGEMENT) override;
 
+		/**
+		 * Takes the next network-layer packet off the queue, which is handed back through deletePacket().
+		 * @param num_bits
+		 * @param mac_id
+		 * @return An empty segment.
+		 */
 		virtual L2Packet* requestSegment(unsigned int num_bits, const MacId& mac_id) override;
 
+		bool isThereMoreData(const MacId& mac_id) const override;
+
+		unsigned int getQueuedDataSize(MacId dest) override;
+
+		/** @return Number of link-layer packets received so far; these are destroyed on reception. */
+		size_t getNumReceived() const;
+
 		void init();
 
 		void onEvent(double time) override;
@@ -0,0 +1,61 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_PATHLOSSMODEL_HPP
+#define INTAIRNET_LINKLAYER_GLUE_PATHLOSSMODEL_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/** Maps the distance between sender and receiver to the signal-to-noise ratio at the receiver. */
+	class PathLossModel {
+	public:
+		virtual ~PathLossModel() = default;
+
+		/**
+		 * @param distance In meters.
+		 * @param center_frequency The channel the packet was sent on.
+		 * @return SNR in dB.
+		 */
+		virtual double getSnr(double distance, uint64_t center_frequency) const = 0;
+	};
+
+	/** Free-space path loss at a fixed carrier frequency, which ignores the channel's center frequency. */
+	class FreeSpacePathLoss : public PathLossModel {
+	public:
+		/**
+		 * @param carrier_frequency In Hz; defaults to the LDACS A2A band.
+		 * @param tx_power_dbm
+		 * @param noise_floor_dbm
+		 */
+		explicit FreeSpacePathLoss(double carrier_frequency = 1e9, double tx_power_dbm = 40.0, double noise_floor_dbm = -100.0)
+			: link_budget(tx_power_dbm - noise_floor_dbm - (20.0 * std::log10(carrier_frequency) - 147.55)) {}
+
+		double getSnr(double distance, uint64_t /* center_frequency */) const override {
+			// Closer than a meter is treated as a meter.
+			return link_budget - 20.0 * std::log10(std::max(distance, 1.0));
+		}
+
+	protected:
+		/** SNR at a distance of one meter. */
+		const double link_budget;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_PATHLOSSMODEL_HPP
@@ -0,0 +1,146 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <stdexcept>
+#include <chrono>
+#include "PerSlotStatistics.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	size_t roundUpToPowerOfTwo(size_t value) {
+		size_t result = 1;
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+}
+
+PerSlotStatisticsRing::PerSlotStatisticsRing(size_t capacity) : mask(roundUpToPowerOfTwo(capacity) - 1), head(0), tail(0), num_dropped(0) {
+	if (capacity == 0)
+		throw std::invalid_argument("PerSlotStatisticsRing needs a positive capacity.");
+	records = std::unique_ptr<PerSlotRecord[]>(new PerSlotRecord[mask + 1]);
+}
+
+bool PerSlotStatisticsRing::tryPush(const PerSlotRecord& record) {
+	const size_t current_head = head.load(std::memory_order_relaxed);
+	if (current_head - tail.load(std::memory_order_acquire) > mask) {
+		num_dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	records[current_head & mask] = record;
+	head.store(current_head + 1, std::memory_order_release);
+	return true;
+}
+
+bool PerSlotStatisticsRing::tryPop(PerSlotRecord& record) {
+	return popBatch(&record, 1) == 1;
+}
+
+size_t PerSlotStatisticsRing::popBatch(PerSlotRecord* target, size_t max_num) {
+	const size_t current_tail = tail.load(std::memory_order_relaxed);
+	const size_t available = head.load(std::memory_order_acquire) - current_tail;
+	const size_t num = available < max_num ? available : max_num;
+	for (size_t i = 0; i < num; i++)
+		target[i] = records[(current_tail + i) & mask];
+	tail.store(current_tail + num, std::memory_order_release);
+	return num;
+}
+
+size_t PerSlotStatisticsRing::size() const {
+	return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+}
+
+size_t PerSlotStatisticsRing::capacity() const {
+	return mask + 1;
+}
+
+uint64_t PerSlotStatisticsRing::getNumDropped() const {
+	return num_dropped.load(std::memory_order_relaxed);
+}
+
+PerSlotStatisticsWriter::PerSlotStatisticsWriter(PerSlotStatisticsRing& ring, const std::string& filename, unsigned int poll_interval_ms) : ring(ring), file(filename, std::ios::binary | std::ios::trunc), poll_interval_ms(poll_interval_ms), num_written(0) {
+	if (!file.is_open())
+		throw std::runtime_error("PerSlotStatisticsWriter couldn't open '" + filename + "'.");
+	thread = std::thread(&PerSlotStatisticsWriter::run, this);
+}
+
+PerSlotStatisticsWriter::~PerSlotStatisticsWriter() {
+	stop();
+}
+
+void PerSlotStatisticsWriter::stop() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		is_stopping = true;
+	}
+	stop_requested.notify_one();
+	if (thread.joinable())
+		thread.join();
+	if (file.is_open()) {
+		// The producer may have pushed more records after the thread's last pass.
+		while (drain() > 0);
+		file.close();
+	}
+}
+
+uint64_t PerSlotStatisticsWriter::getNumWritten() const {
+	return num_written.load(std::memory_order_relaxed);
+}
+
+void PerSlotStatisticsWriter::run() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (!is_stopping) {
+		lock.unlock();
+		const size_t num_drained = drain();
+		lock.lock();
+		if (num_drained == 0)
+			stop_requested.wait_for(lock, std::chrono::milliseconds(poll_interval_ms), [this] { return is_stopping; });
+	}
+}
+
+size_t PerSlotStatisticsWriter::drain() {
+	PerSlotRecord batch[256];
+	size_t total = 0, num;
+	while ((num = ring.popBatch(batch, 256)) > 0) {
+		file.write(reinterpret_cast<const char*>(batch), num * sizeof(PerSlotRecord));
+		total += num;
+	}
+	if (total > 0) {
+		file.flush();
+		num_written.fetch_add(total, std::memory_order_relaxed);
+	}
+	return total;
+}
+
+void PerSlotStatisticsCapture::allocate(size_t capacity) {
+	if (ring == nullptr)
+		ring = std::unique_ptr<PerSlotStatisticsRing>(new PerSlotStatisticsRing(capacity));
+}
+
+void PerSlotStatisticsCapture::startWriter(const std::string& filename) {
+	if (ring == nullptr)
+		throw std::runtime_error("PerSlotStatisticsCapture::startWriter called before the buffer was allocated.");
+	stopWriter();
+	writer = std::unique_ptr<PerSlotStatisticsWriter>(new PerSlotStatisticsWriter(*ring, filename));
+}
+
+void PerSlotStatisticsCapture::stopWriter() {
+	if (writer != nullptr) {
+		writer->stop();
+		writer.reset();
+	}
+}
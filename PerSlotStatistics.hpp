@@ -0,0 +1,188 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_PERSLOTSTATISTICS_HPP
+#define INTAIRNET_LINKLAYER_GLUE_PERSLOTSTATISTICS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/** A fixed-size per-slot statistic sample, written verbatim (native byte order) to the binary output file. */
+	struct PerSlotRecord {
+		PerSlotRecord() = default;
+		PerSlotRecord(uint64_t slot, int32_t mac_id, uint32_t kind, double value) : slot(slot), mac_id(mac_id), kind(kind), value(value) {}
+
+		uint64_t slot = 0;
+		int32_t mac_id = 0;
+		/** User-defined identifier of the statistic. */
+		uint32_t kind = 0;
+		double value = 0.0;
+	};
+
+	/**
+	 * Bounded single-producer single-consumer ring buffer of per-slot records.
+	 * All memory is allocated on construction, so memory consumption does not grow with the simulation length.
+	 * The producer (the MAC) never blocks: if the buffer is full, the record is dropped and counted.
+	 * The consumer is typically a PerSlotStatisticsWriter running on a background thread.
+	 */
+	class PerSlotStatisticsRing {
+	public:
+		/**
+		 * @param capacity Minimum number of records that can be buffered; rounded up to the next power of two.
+		 * @throws std::invalid_argument If capacity is zero.
+		 */
+		explicit PerSlotStatisticsRing(size_t capacity);
+
+		PerSlotStatisticsRing(const PerSlotStatisticsRing& other) = delete;
+		PerSlotStatisticsRing& operator=(const PerSlotStatisticsRing& other) = delete;
+
+		/**
+		 * Producer side. Never blocks.
+		 * @param record
+		 * @return Whether the record was stored; false if the buffer was full and the record was dropped.
+		 */
+		bool tryPush(const PerSlotRecord& record);
+
+		/**
+		 * Consumer side. Never blocks.
+		 * @param record Set to the oldest buffered record if one was available.
+		 * @return Whether a record was removed.
+		 */
+		bool tryPop(PerSlotRecord& record);
+
+		/**
+		 * Consumer side. Removes up to 'max_num' records at once.
+		 * @param records Target array holding at least 'max_num' records.
+		 * @param max_num
+		 * @return Number of records removed.
+		 */
+		size_t popBatch(PerSlotRecord* records, size_t max_num);
+
+		/** @return Number of currently buffered records. Only a snapshot if producer or consumer run concurrently. */
+		size_t size() const;
+
+		size_t capacity() const;
+
+		/** @return Number of records dropped because the buffer was full. */
+		uint64_t getNumDropped() const;
+
+	protected:
+		static constexpr size_t cache_line_size = 64;
+
+		const size_t mask;
+		std::unique_ptr<PerSlotRecord[]> records;
+		/**
+		 * Producer and consumer positions live on separate cache lines so that the two threads don't contend.
+		 * This is done through padding rather than alignas, as C++14's operator new doesn't honour over-alignment.
+		 */
+		std::atomic<size_t> head;
+		char head_padding[cache_line_size - sizeof(std::atomic<size_t>)];
+		std::atomic<size_t> tail;
+		char tail_padding[cache_line_size - sizeof(std::atomic<size_t>)];
+		std::atomic<uint64_t> num_dropped;
+	};
+
+	/**
+	 * Drains a PerSlotStatisticsRing to a binary file on a background thread.
+	 * The file is a plain sequence of PerSlotRecord structs.
+	 * The ring must outlive the writer; destroying the writer stops the thread after writing all remaining records.
+	 */
+	class PerSlotStatisticsWriter {
+	public:
+		/**
+		 * Opens the file and starts the background thread.
+		 * @param ring
+		 * @param filename
+		 * @param poll_interval_ms How long the thread sleeps when the ring is empty.
+		 * @throws std::runtime_error If the file cannot be opened.
+		 */
+		PerSlotStatisticsWriter(PerSlotStatisticsRing& ring, const std::string& filename, unsigned int poll_interval_ms = 10);
+
+		PerSlotStatisticsWriter(const PerSlotStatisticsWriter& other) = delete;
+		PerSlotStatisticsWriter& operator=(const PerSlotStatisticsWriter& other) = delete;
+
+		virtual ~PerSlotStatisticsWriter();
+
+		/** Writes all remaining records, stops the thread and closes the file. Safe to call more than once. */
+		void stop();
+
+		/** @return Number of records written so far. */
+		uint64_t getNumWritten() const;
+
+	protected:
+		void run();
+		/** @return Number of records drained in this call. */
+		size_t drain();
+
+		PerSlotStatisticsRing& ring;
+		std::ofstream file;
+		const unsigned int poll_interval_ms;
+		std::atomic<uint64_t> num_written;
+		std::mutex mutex;
+		std::condition_variable stop_requested;
+		bool is_stopping = false;
+		std::thread thread;
+	};
+
+	/**
+	 * Owns the ring buffer and writer of one component, e.g. a MAC.
+	 * Copies start out empty, so that a copied component never shares the single-producer buffer with the original.
+	 */
+	class PerSlotStatisticsCapture {
+	public:
+		PerSlotStatisticsCapture() = default;
+		PerSlotStatisticsCapture(const PerSlotStatisticsCapture&) {}
+		PerSlotStatisticsCapture& operator=(const PerSlotStatisticsCapture&) {
+			return *this;
+		}
+
+		/**
+		 * Allocates the ring buffer unless it already exists.
+		 * @param capacity
+		 */
+		void allocate(size_t capacity);
+
+		/**
+		 * Starts draining the buffer into a file, replacing any previous writer.
+		 * @param filename
+		 * @throws std::runtime_error If the buffer hasn't been allocated or the file cannot be opened.
+		 */
+		void startWriter(const std::string& filename);
+
+		void stopWriter();
+
+		/** @return The buffer, or nullptr if it hasn't been allocated. */
+		PerSlotStatisticsRing* getRing() {
+			return ring.get();
+		}
+
+	protected:
+		std::unique_ptr<PerSlotStatisticsRing> ring;
+		/** Declared after 'ring' so that it is destroyed (and stopped) first. */
+		std::unique_ptr<PerSlotStatisticsWriter> writer;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_PERSLOTSTATISTICS_HPP
@@ -0,0 +1,109 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "QuantileStatistic.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+QuantileStatistic::QuantileStatistic(const std::string& name, IOmnetPluggable *creator, const std::vector<double>& quantiles, unsigned int emission_interval)
+	: DistributionStatistic(name, creator, quantiles, emission_interval) {
+	for (double quantile : this->quantiles)
+		estimators.emplace_back(quantile);
+}
+
+double QuantileStatistic::getQuantile(double quantile) const {
+	for (size_t i = 0; i < quantiles.size(); i++)
+		if (quantiles.at(i) == quantile)
+			return count == 0 ? 0.0 : estimators.at(i).get();
+	throw std::invalid_argument("QuantileStatistic::getQuantile for quantile " + std::to_string(quantile) + " that isn't estimated.");
+}
+
+void QuantileStatistic::record(double sample) {
+	for (auto& estimator : estimators)
+		estimator.add(sample);
+}
+
+QuantileStatistic::Estimator::Estimator(double quantile) : quantile(quantile) {
+	heights.fill(0.0);
+	for (size_t i = 0; i < 5; i++)
+		positions[i] = (double) i;
+	desired_positions = {0.0, 2.0 * quantile, 4.0 * quantile, 2.0 + 2.0 * quantile, 4.0};
+	increments = {0.0, quantile / 2.0, quantile, (1.0 + quantile) / 2.0, 1.0};
+}
+
+void QuantileStatistic::Estimator::add(double sample) {
+	// The first five samples initialize the markers.
+	if (num_samples < 5) {
+		heights[num_samples++] = sample;
+		if (num_samples == 5)
+			std::sort(heights.begin(), heights.end());
+		return;
+	}
+	num_samples++;
+	// Find the cell the sample falls into, extending the outer markers if needed.
+	size_t cell;
+	if (sample < heights[0]) {
+		heights[0] = sample;
+		cell = 0;
+	} else if (sample >= heights[4]) {
+		heights[4] = sample;
+		cell = 3;
+	} else {
+		cell = 0;
+		while (sample >= heights[cell + 1])
+			cell++;
+	}
+	for (size_t i = cell + 1; i < 5; i++)
+		positions[i]++;
+	for (size_t i = 0; i < 5; i++)
+		desired_positions[i] += increments[i];
+	// Move the middle markers towards their desired positions.
+	for (size_t i = 1; i < 4; i++) {
+		const double offset = desired_positions[i] - positions[i];
+		if ((offset >= 1.0 && positions[i + 1] - positions[i] > 1.0) || (offset <= -1.0 && positions[i - 1] - positions[i] < -1.0)) {
+			const int direction = offset > 0.0 ? 1 : -1;
+			const double candidate = parabolic(i, direction);
+			if (heights[i - 1] < candidate && candidate < heights[i + 1])
+				heights[i] = candidate;
+			else
+				heights[i] = linear(i, direction);
+			positions[i] += direction;
+		}
+	}
+}
+
+double QuantileStatistic::Estimator::get() const {
+	if (num_samples >= 5)
+		return heights[2];
+	// Too few samples for the markers: use the exact nearest-rank quantile.
+	std::array<double, 5> sorted = heights;
+	std::sort(sorted.begin(), sorted.begin() + num_samples);
+	const size_t rank = std::max(size_t(1), (size_t) std::ceil(quantile * num_samples));
+	return sorted[rank - 1];
+}
+
+double QuantileStatistic::Estimator::parabolic(size_t i, double direction) const {
+	return heights[i] + direction / (positions[i + 1] - positions[i - 1]) * (
+		(positions[i] - positions[i - 1] + direction) * (heights[i + 1] - heights[i]) / (positions[i + 1] - positions[i])
+		+ (positions[i + 1] - positions[i] - direction) * (heights[i] - heights[i - 1]) / (positions[i] - positions[i - 1]));
+}
+
+double QuantileStatistic::Estimator::linear(size_t i, int direction) const {
+	return heights[i] + direction * (heights[i + direction] - heights[i]) / (positions[i + direction] - positions[i]);
+}
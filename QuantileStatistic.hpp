@@ -0,0 +1,68 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef TUHH_INTAIRNET_MC_SOTDMA_QUANTILESTATISTIC_HPP
+#define TUHH_INTAIRNET_MC_SOTDMA_QUANTILESTATISTIC_HPP
+
+#include <array>
+#include "DistributionStatistic.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Estimates each configured quantile with the P-square algorithm (Jain and Chlamtac, 1985),
+	 * which keeps five markers per quantile and needs neither the samples nor a value range in advance.
+	 */
+	class QuantileStatistic : public DistributionStatistic {
+	public:
+		QuantileStatistic(const std::string& name, IOmnetPluggable *creator, const std::vector<double>& quantiles = {0.5, 0.9, 0.99}, unsigned int emission_interval = 1);
+
+		/**
+		 * @param quantile One of the quantiles passed on construction.
+		 * @return
+		 * @throws std::invalid_argument For quantiles that aren't estimated.
+		 */
+		double getQuantile(double quantile) const override;
+
+	protected:
+		void record(double sample) override;
+
+		/** P-square estimator of a single quantile. */
+		class Estimator {
+		public:
+			explicit Estimator(double quantile);
+			void add(double sample);
+			double get() const;
+
+		protected:
+			double parabolic(size_t i, double direction) const;
+			double linear(size_t i, int direction) const;
+
+			const double quantile;
+			size_t num_samples = 0;
+			/** Marker heights. */
+			std::array<double, 5> heights;
+			/** Actual and desired marker positions. */
+			std::array<double, 5> positions, desired_positions;
+			/** Desired position increments per sample. */
+			std::array<double, 5> increments;
+		};
+
+		std::vector<Estimator> estimators;
+	};
+}
+
+#endif //TUHH_INTAIRNET_MC_SOTDMA_QUANTILESTATISTIC_HPP
@@ -0,0 +1,73 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <stdexcept>
+#include <string>
+#include "ReceiverBank.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+constexpr size_t ReceiverBank::unknown_channel;
+
+ReceiverBank::ReceiverBank(size_t num_receivers) : receiver_channels(num_receivers, unknown_channel) {
+	if (num_receivers == 0)
+		throw std::invalid_argument("ReceiverBank needs at least one receiver.");
+}
+
+size_t ReceiverBank::tune(uint64_t center_frequency) {
+	if (num_tuned == receiver_channels.size())
+		throw std::runtime_error("ReceiverBank::tune exceeds number of available receivers.");
+	size_t channel = getChannelIndex(center_frequency);
+	if (channel == unknown_channel) {
+		channel = channel_frequencies.size();
+		channel_indices.emplace(center_frequency, channel);
+		channel_frequencies.push_back(center_frequency);
+		num_tuned_per_channel.push_back(0);
+	}
+	num_tuned_per_channel[channel]++;
+	receiver_channels[num_tuned] = channel;
+	return num_tuned++;
+}
+
+bool ReceiverBank::isTunedTo(uint64_t center_frequency) const {
+	const size_t channel = getChannelIndex(center_frequency);
+	return channel != unknown_channel && num_tuned_per_channel[channel] > 0;
+}
+
+void ReceiverBank::clear() {
+	for (size_t receiver = 0; receiver < num_tuned; receiver++)
+		num_tuned_per_channel[receiver_channels[receiver]] = 0;
+	num_tuned = 0;
+}
+
+size_t ReceiverBank::getNumReceivers() const {
+	return receiver_channels.size();
+}
+
+size_t ReceiverBank::getNumTuned() const {
+	return num_tuned;
+}
+
+uint64_t ReceiverBank::getFrequency(size_t receiver) const {
+	if (receiver >= num_tuned)
+		throw std::out_of_range("ReceiverBank::getFrequency for untuned receiver " + std::to_string(receiver) + ".");
+	return channel_frequencies[receiver_channels[receiver]];
+}
+
+size_t ReceiverBank::getChannelIndex(uint64_t center_frequency) const {
+	const auto it = channel_indices.find(center_frequency);
+	return it == channel_indices.end() ? unknown_channel : it->second;
+}
@@ -0,0 +1,90 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_RECEIVERBANK_HPP
+#define INTAIRNET_LINKLAYER_GLUE_RECEIVERBANK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * A fixed number of receivers, each of which can be tuned to one center frequency per time slot.
+	 * Center frequencies are mapped to dense channel indices the first time they are seen,
+	 * so that checking whether any receiver is tuned to a frequency is a hash lookup and an array access.
+	 * Retuning after clear() does not allocate for frequencies that have been seen before.
+	 */
+	class ReceiverBank {
+	public:
+		/** Returned by getChannelIndex() for unknown frequencies. */
+		static constexpr size_t unknown_channel = SIZE_MAX;
+
+		/**
+		 * @param num_receivers
+		 * @throws std::invalid_argument If there are no receivers.
+		 */
+		explicit ReceiverBank(size_t num_receivers);
+
+		/**
+		 * Tunes the next idle receiver.
+		 * @param center_frequency
+		 * @return Index of the tuned receiver.
+		 * @throws std::runtime_error If all receivers are tuned already.
+		 */
+		size_t tune(uint64_t center_frequency);
+
+		/**
+		 * @param center_frequency
+		 * @return Whether any receiver is tuned to the frequency.
+		 */
+		bool isTunedTo(uint64_t center_frequency) const;
+
+		/** Untunes all receivers. */
+		void clear();
+
+		size_t getNumReceivers() const;
+
+		/** @return Number of receivers that are currently tuned. */
+		size_t getNumTuned() const;
+
+		/**
+		 * @param receiver
+		 * @return The frequency the receiver is tuned to.
+		 * @throws std::out_of_range If the receiver isn't tuned.
+		 */
+		uint64_t getFrequency(size_t receiver) const;
+
+		/**
+		 * @param center_frequency
+		 * @return Dense index of the frequency, or 'unknown_channel' if no receiver has ever been tuned to it.
+		 */
+		size_t getChannelIndex(uint64_t center_frequency) const;
+
+	protected:
+		std::unordered_map<uint64_t, size_t> channel_indices;
+		std::vector<uint64_t> channel_frequencies;
+		/** Number of receivers tuned to each channel. */
+		std::vector<unsigned int> num_tuned_per_channel;
+		/** Channel of each tuned receiver; the first 'num_tuned' entries are valid. */
+		std::vector<size_t> receiver_channels;
+		size_t num_tuned = 0;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_RECEIVERBANK_HPP
@@ -0,0 +1,153 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "ReferenceChannel.hpp"
+#include "IPhy.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+ReferenceChannel::ReferenceChannel(double range, std::unique_ptr<PathLossModel> path_loss_model) : range(range), path_loss_model(std::move(path_loss_model)), grid(range > 0.0 ? range : 1.0) {
+	if (!(range > 0.0))
+		throw std::invalid_argument("ReferenceChannel requires a positive range.");
+	if (this->path_loss_model == nullptr)
+		this->path_loss_model = std::unique_ptr<PathLossModel>(new FreeSpacePathLoss());
+}
+
+ReferenceChannel::~ReferenceChannel() {
+	for (auto& transmission : pending)
+		L2Packet::destroy(transmission.packet);
+}
+
+void ReferenceChannel::setMinimumSnr(double snr) {
+	this->minimum_snr = snr;
+}
+
+void ReferenceChannel::attach(ReferenceRadio* radio) {
+	if (!radios.emplace(radio->getId().getId(), radio).second)
+		throw std::invalid_argument("ReferenceChannel::attach for already attached ID " + std::to_string(radio->getId().getId()) + ".");
+	grid.update(radio->getId(), radio->getPosition());
+}
+
+void ReferenceChannel::detach(ReferenceRadio* radio) {
+	auto it = radios.find(radio->getId().getId());
+	if (it != radios.end() && it->second == radio) {
+		radios.erase(it);
+		grid.erase(radio->getId());
+	}
+}
+
+void ReferenceChannel::onPositionChanged(const ReferenceRadio* radio) {
+	grid.update(radio->getId(), radio->getPosition());
+}
+
+void ReferenceChannel::transmit(const ReferenceRadio* sender, L2Packet* packet, uint64_t center_frequency) {
+	std::lock_guard<std::mutex> lock(pending_mutex);
+	pending.push_back({sender->getId().getId(), sender->getPosition(), packet, center_frequency});
+}
+
+size_t ReferenceChannel::distribute() {
+	std::vector<Transmission> transmissions;
+	{
+		std::lock_guard<std::mutex> lock(pending_mutex);
+		transmissions.swap(pending);
+	}
+	// Senders may transmit concurrently; ordering by sender makes the receptions independent of thread timing.
+	std::stable_sort(transmissions.begin(), transmissions.end(), [](const Transmission& a, const Transmission& b) {return a.sender < b.sender;});
+	size_t num_receptions = 0;
+	for (const auto& transmission : transmissions) {
+		// Fill the packet's header size cache now, so that receivers in different threads only read the shared packet.
+		transmission.packet->getBits();
+		// Receivers share the packet, which is deleted together with the last reception.
+		const L2PacketReception shared = L2PacketReception(transmission.packet);
+		for (const MacId& id : grid.neighborsWithin(transmission.position, range)) {
+			if (id.getId() == transmission.sender)
+				continue;
+			ReferenceRadio* receiver = radios.at(id.getId());
+			IPhy* phy = receiver->getPhy();
+			if (phy == nullptr || !phy->isTunedTo(transmission.center_frequency))
+				continue;
+			const SimulatorPosition& position = receiver->getPosition();
+			const double dx = position.x - transmission.position.x, dy = position.y - transmission.position.y, dz = position.z - transmission.position.z;
+			ReferenceRadio::Reception reception = ReferenceRadio::Reception(shared, transmission.center_frequency);
+			reception.reception.descriptor.receptionDist = std::sqrt(dx*dx + dy*dy + dz*dz);
+			reception.reception.descriptor.snr = path_loss_model->getSnr(reception.reception.descriptor.receptionDist, transmission.center_frequency);
+			reception.reception.descriptor.hasChannelError = reception.reception.descriptor.snr < minimum_snr;
+			receiver->inbox.push_back(std::move(reception));
+			num_receptions++;
+		}
+	}
+	return num_receptions;
+}
+
+size_t ReferenceChannel::deliver() {
+	const size_t num_receptions = distribute();
+	for (auto& item : radios)
+		item.second->deliverPending();
+	return num_receptions;
+}
+
+size_t ReferenceChannel::getNumPending() const {
+	std::lock_guard<std::mutex> lock(pending_mutex);
+	return pending.size();
+}
+
+size_t ReferenceChannel::getNumRadios() const {
+	return radios.size();
+}
+
+ReferenceRadio::ReferenceRadio(ReferenceChannel& channel, const MacId& id, const SimulatorPosition& position) : channel(channel), id(id), position(position) {
+	channel.attach(this);
+}
+
+ReferenceRadio::~ReferenceRadio() {
+	channel.detach(this);
+}
+
+void ReferenceRadio::sendToChannel(L2Packet* packet, uint64_t center_frequency) {
+	channel.transmit(this, packet, center_frequency);
+}
+
+void ReferenceRadio::receiveFromChannel(L2Packet* packet, uint64_t center_frequency) {
+	IRadio::receiveFromChannel(packet, center_frequency);
+}
+
+void ReferenceRadio::deliverPending() {
+	// Sending from within the reception handlers only queues at the channel, so the inbox stays untouched.
+	for (auto& reception : inbox)
+		receiveSharedFromChannel(std::move(reception.reception), reception.center_frequency);
+	inbox.clear();
+}
+
+size_t ReferenceRadio::getNumPending() const {
+	return inbox.size();
+}
+
+void ReferenceRadio::setPosition(const SimulatorPosition& position) {
+	this->position = position;
+	channel.onPositionChanged(this);
+}
+
+const SimulatorPosition& ReferenceRadio::getPosition() const {
+	return position;
+}
+
+const MacId& ReferenceRadio::getId() const {
+	return id;
+}
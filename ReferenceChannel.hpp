@@ -0,0 +1,171 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_REFERENCECHANNEL_HPP
+#define INTAIRNET_LINKLAYER_GLUE_REFERENCECHANNEL_HPP
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "IRadio.hpp"
+#include "MacId.hpp"
+#include "PathLossModel.hpp"
+#include "SimulatorPosition.hpp"
+#include "SpatialGrid.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	class ReferenceRadio;
+
+	/**
+	 * In-process broadcast channel, which lets the glue stack run without a simulator.
+	 * Packets sent during a time slot are collected, and deliver() hands each to every attached radio within range whose PHY is tuned to its center frequency.
+	 * A spatial grid skips radios out of range, and a path-loss model sets each receiver's distance and SNR.
+	 * All receivers share the sent packet through L2PacketReception, so that it is copied only by receivers that modify it.
+	 */
+	class ReferenceChannel {
+	public:
+		/**
+		 * @param range Maximum distance between sender and receiver, in meters.
+		 * @param path_loss_model Determines the SNR at the receiver; free-space path loss if unset.
+		 * @throws std::invalid_argument If 'range' is not positive.
+		 */
+		explicit ReferenceChannel(double range, std::unique_ptr<PathLossModel> path_loss_model = nullptr);
+
+		ReferenceChannel(const ReferenceChannel& other) = delete;
+		ReferenceChannel& operator=(const ReferenceChannel& other) = delete;
+
+		/** Drops all undelivered packets. Radios must be destroyed or detached before. */
+		virtual ~ReferenceChannel();
+
+		/**
+		 * Receptions with a lower SNR are delivered with a channel error.
+		 * @param snr In dB.
+		 */
+		void setMinimumSnr(double snr);
+
+		/**
+		 * Makes the radio reachable at its current position.
+		 * @param radio
+		 * @throws std::invalid_argument If a radio with the same ID is attached.
+		 */
+		void attach(ReferenceRadio* radio);
+
+		void detach(ReferenceRadio* radio);
+
+		/**
+		 * Called by the radio whenever it moves.
+		 * @param radio
+		 */
+		void onPositionChanged(const ReferenceRadio* radio);
+
+		/**
+		 * Queues a packet until the next deliver(). May be called from several threads at once.
+		 * @param sender
+		 * @param packet The channel takes ownership.
+		 * @param center_frequency
+		 */
+		void transmit(const ReferenceRadio* sender, L2Packet* packet, uint64_t center_frequency);
+
+		/**
+		 * Moves all queued packets into the inboxes of their receivers.
+		 * @return Number of receptions.
+		 */
+		size_t distribute();
+
+		/**
+		 * Distributes all queued packets and passes each radio's receptions to its PHY.
+		 * @return Number of receptions.
+		 */
+		size_t deliver();
+
+		/** @return Number of packets queued since the last delivery. */
+		size_t getNumPending() const;
+
+		size_t getNumRadios() const;
+
+	protected:
+		struct Transmission {
+			int sender;
+			SimulatorPosition position;
+			L2Packet* packet;
+			uint64_t center_frequency;
+		};
+
+		const double range;
+		std::unique_ptr<PathLossModel> path_loss_model;
+		double minimum_snr = -std::numeric_limits<double>::infinity();
+		std::unordered_map<int, ReferenceRadio*> radios;
+		SpatialGrid grid;
+		std::vector<Transmission> pending;
+		mutable std::mutex pending_mutex;
+	};
+
+	/** IRadio that sends to and receives from a ReferenceChannel. */
+	class ReferenceRadio : public IRadio {
+		friend class ReferenceChannel;
+	public:
+		/**
+		 * Attaches to the channel.
+		 * @param channel Must outlive this radio.
+		 * @param id
+		 * @param position In meters.
+		 */
+		ReferenceRadio(ReferenceChannel& channel, const MacId& id, const SimulatorPosition& position);
+
+		ReferenceRadio(const ReferenceRadio& other) = delete;
+		ReferenceRadio& operator=(const ReferenceRadio& other) = delete;
+
+		/** Detaches from the channel. Undelivered receptions are dropped. */
+		~ReferenceRadio() override;
+
+		void sendToChannel(L2Packet* packet, uint64_t center_frequency) override;
+
+		void receiveFromChannel(L2Packet* packet, uint64_t center_frequency) override;
+
+		/**
+		 * Passes all receptions that the channel distributed to this radio to the PHY.
+		 * Touches only this radio and its PHY, so different radios can do so in parallel.
+		 */
+		void deliverPending();
+
+		/** @return Number of receptions waiting for deliverPending(). */
+		size_t getNumPending() const;
+
+		void setPosition(const SimulatorPosition& position);
+
+		const SimulatorPosition& getPosition() const;
+
+		const MacId& getId() const;
+
+	protected:
+		struct Reception {
+			Reception(L2PacketReception reception, uint64_t center_frequency) : reception(std::move(reception)), center_frequency(center_frequency) {}
+
+			L2PacketReception reception;
+			uint64_t center_frequency;
+		};
+
+		ReferenceChannel& channel;
+		const MacId id;
+		SimulatorPosition position;
+		std::vector<Reception> inbox;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_REFERENCECHANNEL_HPP
@@ -0,0 +1,38 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ReservationPhy.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+ReservationPhy::ReservationPhy(size_t num_receivers, size_t reservation_horizon) : IPhy(num_receivers, reservation_horizon) {}
+
+bool ReservationPhy::isTransmitterIdle(unsigned int slot_offset, unsigned int num_slots) const {
+	return transmitter_reservations.isIdle(slot_offset, num_slots);
+}
+
+bool ReservationPhy::isAnyReceiverIdle(unsigned int slot_offset, unsigned int num_slots) const {
+	for (const auto& reservations : receiver_reservations)
+		if (reservations.isIdle(slot_offset, num_slots))
+			return true;
+	return false;
+}
+
+void ReservationPhy::tuneReceiver(uint64_t center_frequency) {
+	IPhy::tuneReceiver(center_frequency);
+	// Receivers are tuned in index order.
+	receiver_reservations[receivers.getNumTuned() - 1].reserve(0);
+}
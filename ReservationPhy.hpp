@@ -0,0 +1,50 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_RESERVATIONPHY_HPP
+#define INTAIRNET_LINKLAYER_GLUE_RESERVATIONPHY_HPP
+
+#include "IPhy.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Base for PHYs that don't track busy slots themselves: the idle queries are answered from the transmitter and receiver reservations with a few mask tests.
+	 * Tuning a receiver reserves it for the current slot. Subclasses reserve the transmitter when they transmit, and upcoming slots can be reserved through getTransmitterReservations() and getReceiverReservations().
+	 */
+	class ReservationPhy : public IPhy {
+	public:
+		/**
+		 * @param num_receivers
+		 * @param reservation_horizon
+		 * @throws std::invalid_argument If there are no receivers.
+		 */
+		explicit ReservationPhy(size_t num_receivers = 2, size_t reservation_horizon = 1024);
+
+		bool isTransmitterIdle(unsigned int slot_offset, unsigned int num_slots) const override;
+
+		bool isAnyReceiverIdle(unsigned int slot_offset, unsigned int num_slots) const override;
+
+		/**
+		 * Also reserves the tuned receiver for the current slot.
+		 * @param center_frequency
+		 * @throws std::runtime_error If the number of available receivers is exceeded.
+		 */
+		void tuneReceiver(uint64_t center_frequency) override;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_RESERVATIONPHY_HPP
@@ -19,21 +19,80 @@
 
 using namespace TUHH_INTAIRNET_MCSOTDMA;
 
-IntegerUniformRng::IntegerUniformRng() : random_device(), generator(random_device()) {}
+// Mixing the stream index separately keeps streams of neighbouring indices and seeds far apart.
+IntegerUniformRng::IntegerUniformRng(uint64_t seed, uint64_t stream) : state(mix(seed ^ mix(stream + increment))) {}
 
 int IntegerUniformRng::get(int min, int max) {
-	dist = std::uniform_int_distribution<>(min, max - 1);
-	return dist(generator);
+	if (max <= min)
+		return min;
+	return (int) ((int64_t) min + nextBounded((uint32_t) ((int64_t) max - min)));
 }
 
-IRng::IRng() {
+void IntegerUniformRng::fill(int min, int max, int* values, size_t num) {
+	if (max <= min) {
+		for (size_t i = 0; i < num; i++)
+			values[i] = min;
+		return;
+	}
+	const uint32_t range = (uint32_t) ((int64_t) max - min);
+	const uint32_t threshold = (0u - range) % range;
+	const uint64_t base = state;
+	bool any_rejected = false;
+	for (size_t i = 0; i < num; i++) {
+		const uint64_t product = (mix(base + (i + 1) * increment) >> 32) * range;
+		any_rejected |= (uint32_t) product < threshold;
+		values[i] = (int) ((int64_t) min + (int64_t) (product >> 32));
+	}
+	state = base + num * increment;
+	if (any_rejected) {
+		for (size_t i = 0; i < num; i++)
+			if ((uint32_t) ((mix(base + (i + 1) * increment) >> 32) * range) < threshold)
+				values[i] = (int) ((int64_t) min + nextBounded(range));
+	}
+}
+
+uint32_t IntegerUniformRng::nextBounded(uint32_t range) {
+	uint64_t product = (next() >> 32) * range;
+	uint32_t low = (uint32_t) product;
+	if (low < range) {
+		// Reject the few values that would make the lower part of the range more likely.
+		const uint32_t threshold = (0u - range) % range;
+		while (low < threshold) {
+			product = (next() >> 32) * range;
+			low = (uint32_t) product;
+		}
+	}
+	return (uint32_t) (product >> 32);
+}
+
+thread_local RngProvider* RngProvider::bound_provider = nullptr;
+
+IRng::IRng() : provider(nullptr) {
 	RngProvider::getInstance().signupInt(this);
 }
 
 int IRng::getRandomInt(int min, int max) {
-	return RngProvider::getInstance().getInt(this, min, max);
+	if (provider == nullptr)
+		throw std::invalid_argument("IRng::getRandomInt for unregistered caller.");
+	return provider->getInt(this, min, max);
+}
+
+void IRng::fillRandomInts(int min, int max, int* values, size_t num) {
+	getIntRng().fill(min, max, values, num);
+}
+
+std::vector<int> IRng::getRandomInts(int min, int max, size_t num) {
+	std::vector<int> values = std::vector<int>(num);
+	fillRandomInts(min, max, values.data(), num);
+	return values;
+}
+
+IntRng& IRng::getIntRng() {
+	if (provider == nullptr)
+		throw std::invalid_argument("IRng::getIntRng for unregistered caller.");
+	return provider->getIntRng(this);
 }
 
 int OmnetIntegerUniformRng::get(int min, int max) {
-	return RngProvider::getInstance().omnetGetInt(min, max, this->k);
+	return (provider != nullptr ? *provider : RngProvider::getInstance()).omnetGetInt(min, max, this->k);
 }
@@ -17,12 +17,18 @@
 #ifndef INTAIRNET_LINKLAYER_GLUE_RNGPROVIDER_HPP
 #define INTAIRNET_LINKLAYER_GLUE_RNGPROVIDER_HPP
 
-#include <map>
+#include <deque>
+#include <limits>
+#include <vector>
 #include <stdexcept>
-#include <random>
+#include <cstdint>
 #include <functional>
+#include <string>
+#include <utility>
 
 namespace TUHH_INTAIRNET_MCSOTDMA {
+	class RngProvider; // Forward-declaration so that RNGs and their users can refer to the provider they belong to.
+
 	class IntRng {
 	public:
 		/**
@@ -31,21 +37,64 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 * @return Random integer from [min, max).
 		 */
 		virtual int get(int min, int max) = 0;
+
+		/**
+		 * Draws 'num' random integers at once. The default implementation calls get() for each.
+		 * @param min Inclusive
+		 * @param max Exclusive
+		 * @param values Target array holding at least 'num' integers.
+		 * @param num
+		 */
+		virtual void fill(int min, int max, int* values, size_t num) {
+			for (size_t i = 0; i < num; i++)
+				values[i] = get(min, max);
+		}
+
 		virtual ~IntRng() = default;
 	};
 	/**
-	 * C++-default random number generator for integer values.
+	 * Default random number generator for integer values.
+	 * A SplitMix64 stream: the output for the n-th draw is a bijective mix of 'key + n * increment', so its entire state is a single counter.
+	 * Integers are drawn from a range without bias through Lemire's multiply-and-reject method.
 	 */
 	class IntegerUniformRng : public IntRng {
 	public:
-		IntegerUniformRng();
+		/**
+		 * @param seed Global seed.
+		 * @param stream Index of this stream; different streams with the same seed are independent.
+		 */
+		IntegerUniformRng(uint64_t seed, uint64_t stream);
 
+		/**
+		 * @param min Inclusive
+		 * @param max Exclusive
+		 * @return Random integer from [min, max), or min if the range is empty.
+		 */
 		int get(int min, int max) override;
 
+		/** Computes all draws of the batch independently from the counter, so that the loop can be vectorized; only the rare rejected draws are redone afterwards. */
+		void fill(int min, int max, int* values, size_t num) override;
+
+		/** @return The next 64 random bits. */
+		uint64_t next() {
+			state += increment;
+			return mix(state);
+		}
+
+		/** @return Random integer from [0, range). */
+		uint32_t nextBounded(uint32_t range);
+
+		/** SplitMix64's finalizer. */
+		static uint64_t mix(uint64_t value) {
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+			return value ^ (value >> 31);
+		}
+
 	protected:
-		std::uniform_int_distribution<> dist;
-		std::random_device random_device;
-		std::mt19937 generator;
+		/** Golden-ratio increment of SplitMix64. */
+		static constexpr uint64_t increment = 0x9E3779B97F4A7C15ull;
+		uint64_t state;
 	};
 
 	/**
@@ -59,18 +108,28 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 */
 		explicit OmnetIntegerUniformRng(int k) : k(k) {}
 
+		/**
+		 * @param k Index of the OMNeT++-RNG that should be associated with this instance.
+		 * @param provider Provider whose OMNeT++ callback is used.
+		 */
+		OmnetIntegerUniformRng(int k, RngProvider* provider) : k(k), provider(provider) {}
+
 		int get(int min, int max) override;
 
 	protected:
 		/** Association to the OMNeT++-provided RNG at index k. */
 		int k;
+		/** Provider whose OMNeT++ callback is used; if unset, the one returned by RngProvider::getInstance(). */
+		RngProvider* provider = nullptr;
 	};
 
 	/** Interface that classes that wish to obtain a random number generator must implement. */
 	class IRng {
+		friend class RngProvider;
 	public:
 		/**
-		 * Signs up to receive an integer RNG.
+		 * Signs up to receive an integer RNG from RngProvider::getInstance().
+		 * All later draws use that provider, no matter which thread they're made from.
 		 */
 		IRng();
 
@@ -80,51 +139,176 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 * @return A random integer from [min, max).
 		 */
 		int getRandomInt(int min, int max);
+
+		/** @return Index of this instance's stream at its provider. */
+		size_t getStreamIndex() const {
+			return stream;
+		}
+
+		/**
+		 * Draws many random integers with a single generator lookup.
+		 * @param min Inclusive.
+		 * @param max Exclusive.
+		 * @param values Target array holding at least 'num' integers.
+		 * @param num
+		 */
+		void fillRandomInts(int min, int max, int* values, size_t num);
+
+		/**
+		 * @param min Inclusive.
+		 * @param max Exclusive.
+		 * @param num
+		 * @return 'num' random integers from [min, max).
+		 */
+		std::vector<int> getRandomInts(int min, int max, size_t num);
+
+		/**
+		 * Randomly permutes the elements (Fisher-Yates).
+		 * @param elements
+		 */
+		template<typename T>
+		void shuffle(std::vector<T>& elements) {
+			if (elements.size() < 2)
+				return;
+			IntRng& rng = getIntRng();
+			for (size_t i = elements.size() - 1; i > 0; i--)
+				std::swap(elements[i], elements[rng.get(0, (int) i + 1)]);
+		}
+
+		/**
+		 * Draws 'num' distinct elements, each subset being equally likely (partial Fisher-Yates).
+		 * @param candidates
+		 * @param num
+		 * @return The chosen elements in random order.
+		 * @throws std::invalid_argument If there are fewer candidates than requested.
+		 */
+		template<typename T>
+		std::vector<T> getRandomSubset(const std::vector<T>& candidates, size_t num) {
+			if (num > candidates.size())
+				throw std::invalid_argument("IRng::getRandomSubset for " + std::to_string(num) + " out of " + std::to_string(candidates.size()) + " candidates.");
+			std::vector<T> elements = candidates;
+			IntRng& rng = getIntRng();
+			for (size_t i = 0; i < num; i++)
+				std::swap(elements[i], elements[rng.get((int) i, (int) elements.size())]);
+			elements.resize(num);
+			return elements;
+		}
+
+	protected:
+		/** @return This caller's generator. */
+		IntRng& getIntRng();
+
+		/** The provider this instance signed up with. */
+		RngProvider* provider;
+		/** Index of this instance's RNG at 'provider'. */
+		size_t stream = std::numeric_limits<size_t>::max();
+		/** The provider's generation at sign-up; the index is invalid after the provider has been reset. */
+		uint64_t generation = 0;
 	};
 
 	/**
 	 * Provides Random Number Generators (RNGs) to classes.
-	 * By default, it provides C++-standard generators, but it can be configured to use simulator-provided generators instead.
-	 * Implemented through a singleton instance inspired by https://stackoverflow.com/questions/1008019/c-singleton-design-pattern
+	 * By default, it provides the library's default generators, but it can be configured to use simulator-provided generators instead.
+	 * A process-wide default instance is implemented through a singleton inspired by https://stackoverflow.com/questions/1008019/c-singleton-design-pattern
+	 * To run several simulations in parallel, give each its own instance and bind it to the thread that runs it: providers share no state, so their streams are independent.
+	 * A provider must outlive the IRng instances that signed up with it.
 	 */
 	class RngProvider {
 		friend class RngProviderTests;
 	public:
+		/** Binds a provider to the current thread for the lifetime of this object, and restores the previous binding afterwards. */
+		class Binding {
+		public:
+			explicit Binding(RngProvider& provider) : previous(bound_provider) {
+				bound_provider = &provider;
+			}
+
+			Binding(const Binding& other) = delete;
+			Binding& operator=(const Binding& other) = delete;
+
+			~Binding() {
+				bound_provider = previous;
+			}
+
+		protected:
+			RngProvider* previous;
+		};
+
 		/** Function that should be replaced by the OMNeT++ simulator. */
 		std::function<int (int min, int max, int k)> omnetGetInt = [] (int min, int max, int k) {throw std::runtime_error("not implemented"); return 0;};
 
-		// Make sure there can't be >1 instances of the RngProvider.
+		/** Creates an independent provider, e.g. for one of several simulations that run in the same process. */
+		RngProvider() = default;
+
 		RngProvider(RngProvider const&) = delete;
 		void operator=(RngProvider const&) = delete;
 
-		/** Clears the <user, RNG> mapping. */
+		/** Deletes all RNGs. */
 		~RngProvider() {
 			reset();
 		}
 
+		/** @return The provider bound to the current thread, or the process-wide default instance if none is bound. */
 		static RngProvider& getInstance() {
+			if (bound_provider != nullptr)
+				return *bound_provider;
+			return getDefaultInstance();
+		}
+
+		/** @return The process-wide default instance. */
+		static RngProvider& getDefaultInstance() {
 			static RngProvider instance; // Instantiated on first use.
 			return instance;
 		}
 
 		/**
-		 * @param value Whether to use C++-default random number generators.
+		 * @param provider Provider that getInstance() returns on the current thread from now on; nullptr to fall back to the default instance.
+		 */
+		static void bindToCurrentThread(RngProvider* provider) {
+			bound_provider = provider;
+		}
+
+		/**
+		 * @param value Whether to use the library's default random number generators.
 		 */
 		void setUseDefaultRngs(bool value) {
 			this->use_default_rngs = value;
 		}
 
+		/**
+		 * Sets the global seed that default RNGs signed up from now on derive their streams from.
+		 * Runs with the same seed and the same order of sign-ups draw the same numbers.
+		 * @param value
+		 */
+		void setSeed(uint64_t value) {
+			this->seed = value;
+		}
+
+		uint64_t getSeed() const {
+			return seed;
+		}
+
 		/**
 		 * Called once by each class that wishes to obtain an integer random number generator.
+		 * Signing up again returns the existing stream.
 		 * @param caller
+		 * @return Index of the caller's stream, which is also stored in the caller.
 		 */
-		void signupInt(IRng* caller) {
-			if (int_rng_callers.find(caller) == int_rng_callers.end()) {
-				if (use_default_rngs)
-					int_rng_callers[caller] = new IntegerUniformRng();
-				else
-					int_rng_callers[caller] = new OmnetIntegerUniformRng((int) int_rng_callers.size());
+		size_t signupInt(IRng* caller) {
+			if (isSignedUp(caller))
+				return caller->stream;
+			const size_t index = int_rngs.size();
+			if (use_default_rngs) {
+				default_rngs.emplace_back(seed, index);
+				int_rngs.push_back(&default_rngs.back());
+			} else {
+				omnet_rngs.emplace_back((int) index, this);
+				int_rngs.push_back(&omnet_rngs.back());
 			}
+			caller->provider = this;
+			caller->stream = index;
+			caller->generation = generation;
+			return index;
 		}
 
 		/**
@@ -134,21 +318,30 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		 * @param max Exclusive
 		 * @return A random integer from [min, max).
 		 */
-		int getInt(IRng* caller, int min, int max) {
-			auto it = int_rng_callers.find(caller);
-			if (it == int_rng_callers.end())
+		int getInt(const IRng* caller, int min, int max) {
+			if (!isSignedUp(caller))
 				throw std::invalid_argument("RngProvider::getRandomInt for unregistered caller.");
-			return it->second->get(min, max);
+			return int_rngs[caller->stream]->get(min, max);
 		}
 
 		/**
-		 * Clears the <user, RNG> mappings.
+		 * @param caller
+		 * @return The RNG saved for the caller, for drawing many numbers without repeated lookups.
+		 */
+		IntRng& getIntRng(const IRng* caller) {
+			if (!isSignedUp(caller))
+				throw std::invalid_argument("RngProvider::getIntRng for unregistered caller.");
+			return *int_rngs[caller->stream];
+		}
+
+		/**
+		 * Deletes all RNGs. Callers that signed up before must not draw numbers anymore.
 		 */
 		void reset() {
-			// Delete just the RNGs, not the callers.
-			for (auto pair : int_rng_callers)
-				delete pair.second;
-			int_rng_callers.clear();
+			int_rngs.clear();
+			default_rngs.clear();
+			omnet_rngs.clear();
+			generation++;
 		}
 
 		/**
@@ -160,14 +353,23 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		}
 
 	protected:
-		/** Maps RNG-user to RNG. */
-		std::map<IRng*, IntRng*> int_rng_callers;
-		/** Whether to use C++-default RNGs when true, or OMNeT++-provided RNGs when false. */
-		bool use_default_rngs = true;
+		bool isSignedUp(const IRng* caller) const {
+			return caller->provider == this && caller->generation == generation && caller->stream < int_rngs.size();
+		}
 
-	private:
-		/** Private-hidden constructor as per singleton implementation pattern. */
-		RngProvider() {}
+		/** RNG of each stream index. */
+		std::vector<IntRng*> int_rngs;
+		/** Storage of the RNGs; deques keep their addresses stable while growing. */
+		std::deque<IntegerUniformRng> default_rngs;
+		std::deque<OmnetIntegerUniformRng> omnet_rngs;
+		/** Incremented on every reset(), so that stale stream indices are detected. Starts at 1 so that callers that never signed up don't match. */
+		uint64_t generation = 1;
+		/** Whether to use the default RNGs when true, or OMNeT++-provided RNGs when false. */
+		bool use_default_rngs = true;
+		/** Global seed of the default RNGs. */
+		uint64_t seed = 0;
+		/** Provider bound to the current thread, if any. */
+		static thread_local RngProvider* bound_provider;
 	};
 }
 
@@ -32,18 +32,21 @@ uint8_t SequenceNumber::get() const {
 	return this->sequence_number;
 }
 
+namespace {
+	/** Incrementing cycles through [SEQNO_FIRST, SEQNO_MAX-1], skipping over UNSET. */
+	const int INCREMENT_CYCLE = SEQNO_MAX - SEQNO_FIRST;
+	/** Decrementing cycles through [SEQNO_FIRST, SEQNO_MAX], skipping over UNSET. */
+	const int DECREMENT_CYCLE = SEQNO_MAX - SEQNO_FIRST + 1;
+}
+
 void SequenceNumber::increment() {
-	this->sequence_number = (uint8_t) ((this->sequence_number + 1) % SEQNO_MAX);
-	// Skip over UNSET.
-	if (this->get() == SEQNO_UNSET)
-		this->increment();
+	// Both SEQNO_MAX-1 and SEQNO_MAX wrap around to SEQNO_FIRST.
+	this->sequence_number = (uint8_t) (this->sequence_number >= SEQNO_MAX - 1 ? SEQNO_FIRST : this->sequence_number + 1);
 }
 
 void SequenceNumber::decrement() {
-	this->sequence_number = (uint8_t) ((this->sequence_number -1) % SEQNO_MAX);
-	// Skip over UNSET.
-	if (this->get() == SEQNO_UNSET)
-		this->decrement();
+	// Both SEQNO_FIRST and UNSET wrap around to SEQNO_MAX.
+	this->sequence_number = (uint8_t) (this->sequence_number <= SEQNO_FIRST ? SEQNO_MAX : this->sequence_number - 1);
 }
 
 bool SequenceNumber::operator==(const SequenceNumber& other) const {
@@ -52,22 +55,16 @@ bool SequenceNumber::operator==(const SequenceNumber& other) const {
 
 SequenceNumber SequenceNumber::operator+(uint8_t increment) {
 	assert(increment > 0);
-	SequenceNumber ret = SequenceNumber(this->get());
-	for (uint8_t i = 0; i< increment; i++) {
-		ret.increment();
-	}
-
-	return ret;
+	// Same as 'increment' calls to increment(): the first step maps SEQNO_MAX-1 and SEQNO_MAX onto SEQNO_FIRST, all further steps stay within the cycle.
+	const int offset = this->sequence_number >= SEQNO_MAX - 1 ? 0 : this->sequence_number;
+	return SequenceNumber((uint8_t) ((offset + increment - 1) % INCREMENT_CYCLE + SEQNO_FIRST));
 }
 
 SequenceNumber SequenceNumber::operator-(uint8_t decrement) {
 	assert(decrement > 0);
-	SequenceNumber ret = SequenceNumber(this->get());
-	for (uint8_t i = 0; i< decrement; i++) {
-		ret.decrement();
-	}
-
-	return ret;
+	// Same as 'decrement' calls to decrement(): UNSET behaves like SEQNO_FIRST, as both are followed by SEQNO_MAX.
+	const int offset = (this->sequence_number == SEQNO_UNSET ? SEQNO_FIRST : this->sequence_number) - SEQNO_FIRST;
+	return SequenceNumber((uint8_t) (((offset - decrement) % DECREMENT_CYCLE + DECREMENT_CYCLE) % DECREMENT_CYCLE + SEQNO_FIRST));
 }
 
 bool SequenceNumber::operator>(const SequenceNumber& other) const {
@@ -79,27 +76,12 @@ bool SequenceNumber::operator<(const SequenceNumber& other) const {
 }
 
 bool SequenceNumber::isHigherThan(SequenceNumber other, uint8_t windowSize) {
-	uint8_t raw = this->get();
-	uint8_t otherRaw = other.get();
-
-	// A sequence number A is higher than an other one  B if
-	// I) The raw value of A is higher than the raw value of B but the distance is smaller than the window Size
-	if (raw > otherRaw) {
-		uint8_t dist = raw - otherRaw;
-		if (dist < windowSize) {
-			return true;
-		}
-	}
-
-	// 2) The raw value of A is lower than the raw value of B there was a wrap around
-	if (otherRaw > raw) {
-		uint8_t dist = (SEQNO_MAX - otherRaw) + (raw - SEQNO_FIRST);
-
-		if (dist < windowSize) {
-			return true;
-		}
-	}
-	return false;
+	// A sequence number A is higher than an other one B if their distance is smaller than the window size, where
+	// I) the distance is the difference of the raw values if the raw value of A is higher, or
+	// II) the distance wraps around if the raw value of A is lower.
+	const int diff = (int) this->get() - (int) other.get();
+	const uint8_t dist = (uint8_t) (diff > 0 ? diff : diff + (SEQNO_MAX - SEQNO_FIRST));
+	return (diff != 0) & (dist < windowSize);
 }
 
 bool SequenceNumber::isLowerThan(SequenceNumber other, uint8_t windowSize) {
@@ -0,0 +1,81 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include "SlotArena.hpp"
+#include "L2Packet.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+SlotArena::SlotArena(size_t block_size) : block_size(block_size) {}
+
+SlotArena::~SlotArena() {
+	reset();
+}
+
+L2Packet* SlotArena::createPacket() {
+	return create<L2Packet>();
+}
+
+void SlotArena::reset() {
+	for (auto it = destructors.rbegin(); it != destructors.rend(); it++)
+		it->destroy(it->object);
+	destructors.clear();
+	current_block = 0;
+	offset = 0;
+}
+
+bool SlotArena::owns(const void* ptr) const {
+	for (const auto& block : blocks) {
+		const char* begin = block.data.get();
+		if (!std::less<const void*>()(ptr, begin) && std::less<const void*>()(ptr, begin + block.size))
+			return true;
+	}
+	return false;
+}
+
+size_t SlotArena::getNumObjects() const {
+	return destructors.size();
+}
+
+size_t SlotArena::getNumBytesReserved() const {
+	size_t num_bytes = 0;
+	for (const auto& block : blocks)
+		num_bytes += block.size;
+	return num_bytes;
+}
+
+void* SlotArena::allocate(size_t num_bytes, size_t alignment) {
+	while (current_block < blocks.size()) {
+		Block& block = blocks.at(current_block);
+		auto base = reinterpret_cast<uintptr_t>(block.data.get());
+		size_t aligned_offset = (base + offset + alignment - 1) / alignment * alignment - base;
+		if (aligned_offset + num_bytes <= block.size) {
+			offset = aligned_offset + num_bytes;
+			return block.data.get() + aligned_offset;
+		}
+		current_block++;
+		offset = 0;
+	}
+	// Oversized objects get a block of their own.
+	size_t size = std::max(block_size, num_bytes + alignment);
+	blocks.push_back({std::unique_ptr<char[]>(new char[size]), size});
+	current_block = blocks.size() - 1;
+	offset = 0;
+	return allocate(num_bytes, alignment);
+}
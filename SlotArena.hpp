@@ -0,0 +1,151 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_SLOTARENA_HPP
+#define INTAIRNET_LINKLAYER_GLUE_SLOTARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	class L2Packet; // forward declaration so that packets can be created from the arena.
+	class SlotArena;
+
+	/**
+	 * Base of objects that may be created in a SlotArena, which records itself as their owner.
+	 * Code that would delete such an object must check getArena() first, as objects of an arena are destroyed by it.
+	 * Copies never belong to an arena.
+	 */
+	class ArenaObject {
+		friend class SlotArena;
+	public:
+		ArenaObject() = default;
+
+		ArenaObject(const ArenaObject&) {}
+
+		ArenaObject& operator=(const ArenaObject&) {
+			return *this;
+		}
+
+		/**
+		 * @return The arena that destroys this object, or nullptr if it lives on the heap.
+		 */
+		SlotArena* getArena() const {
+			return arena;
+		}
+
+	private:
+		SlotArena* arena = nullptr;
+	};
+
+	/**
+	 * Bump allocator for objects whose lifetime ends with the current time slot, such as packets, their headers and payloads.
+	 * Objects are constructed in large blocks of memory and are destroyed all at once through reset(), which keeps the memory for the next slot.
+	 * Objects obtained from an arena must never be deleted: packets are disposed of through L2Packet::destroy(), and packets skip headers and payloads whose getArena() is set.
+	 */
+	class SlotArena {
+	public:
+		/**
+		 * @param block_size Number of bytes that are reserved at a time.
+		 */
+		explicit SlotArena(size_t block_size = 64*1024);
+
+		SlotArena(const SlotArena& other) = delete;
+		SlotArena& operator=(const SlotArena& other) = delete;
+
+		/** Destroys all objects and frees all memory. */
+		virtual ~SlotArena();
+
+		/**
+		 * Constructs an object inside the arena.
+		 * @param args Constructor arguments.
+		 * @return Pointer to the object, which stays valid until reset() is called.
+		 */
+		template <typename T, typename... Args>
+		T* create(Args&&... args) {
+			void* memory = allocate(sizeof(T), alignof(T));
+			T* object = new (memory) T(std::forward<Args>(args)...);
+			adopt(object);
+			if (!std::is_trivially_destructible<T>::value)
+				destructors.push_back({object, [](void* ptr) {static_cast<T*>(ptr)->~T();}});
+			return object;
+		}
+
+		/**
+		 * @return An empty packet that is destroyed by reset().
+		 */
+		L2Packet* createPacket();
+
+		/**
+		 * Destroys all objects in reverse order of their creation.
+		 * Memory is kept and re-used for objects created afterwards.
+		 */
+		void reset();
+
+		/**
+		 * @param ptr
+		 * @return Whether 'ptr' points into memory that belongs to this arena.
+		 */
+		bool owns(const void* ptr) const;
+
+		/**
+		 * @return Number of objects that will be destroyed upon reset().
+		 */
+		size_t getNumObjects() const;
+
+		/**
+		 * @return Number of bytes currently reserved from the heap.
+		 */
+		size_t getNumBytesReserved() const;
+
+	protected:
+		void* allocate(size_t num_bytes, size_t alignment);
+
+		/** Records this arena as the owner of objects that can tell. */
+		void adopt(ArenaObject* object) {
+			object->arena = this;
+		}
+
+		void adopt(const void*) {}
+
+		class Block {
+		public:
+			std::unique_ptr<char[]> data;
+			size_t size;
+		};
+
+		class Destructor {
+		public:
+			void* object;
+			void (*destroy)(void*);
+		};
+
+		const size_t block_size;
+		std::vector<Block> blocks;
+		/** Index of the block that is currently allocated from. */
+		size_t current_block = 0;
+		/** Number of bytes used in the current block. */
+		size_t offset = 0;
+		std::vector<Destructor> destructors;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_SLOTARENA_HPP
@@ -0,0 +1,118 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SlotExecutor.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+SlotExecutor::SlotExecutor(size_t num_threads) : next_index(0) {
+	if (num_threads == 0)
+		throw std::invalid_argument("SlotExecutor for zero threads.");
+	workers.reserve(num_threads - 1);
+	for (size_t i = 1; i < num_threads; i++)
+		workers.emplace_back(&SlotExecutor::runWorker, this);
+}
+
+SlotExecutor::~SlotExecutor() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		is_stopping = true;
+	}
+	phase_started.notify_all();
+	for (auto& worker : workers)
+		worker.join();
+}
+
+void SlotExecutor::forEach(size_t num_tasks, const std::function<void(size_t)>& task) {
+	if (workers.empty() || num_tasks < 2) {
+		for (size_t i = 0; i < num_tasks; i++)
+			task(i);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->task = &task;
+		this->num_tasks = num_tasks;
+		// Several chunks per thread balance the load without contending for every index.
+		chunk_size = std::max(size_t(1), num_tasks / (8 * getNumThreads()));
+		next_index.store(0, std::memory_order_relaxed);
+		num_busy = workers.size();
+		phase++;
+	}
+	phase_started.notify_all();
+	work();
+	std::exception_ptr phase_error;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		phase_finished.wait(lock, [this] {return num_busy == 0;});
+		this->task = nullptr;
+		std::swap(phase_error, error);
+	}
+	if (phase_error)
+		std::rethrow_exception(phase_error);
+}
+
+void SlotExecutor::runSlot(size_t num_nodes, const std::function<void(size_t)>& transmit, const std::function<void()>& exchange, const std::function<void(size_t)>& receive) {
+	forEach(num_nodes, transmit);
+	if (exchange)
+		exchange();
+	forEach(num_nodes, receive);
+}
+
+size_t SlotExecutor::getNumThreads() const {
+	return workers.size() + 1;
+}
+
+void SlotExecutor::runWorker() {
+	uint64_t last_phase = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			phase_started.wait(lock, [this, last_phase] {return is_stopping || phase != last_phase;});
+			if (is_stopping)
+				return;
+			last_phase = phase;
+		}
+		work();
+		bool is_last;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			is_last = --num_busy == 0;
+		}
+		if (is_last)
+			phase_finished.notify_one();
+	}
+}
+
+void SlotExecutor::work() {
+	// Set before the phase started and constant during it.
+	const std::function<void(size_t)>& task = *this->task;
+	const size_t num_tasks = this->num_tasks, chunk_size = this->chunk_size;
+	for (size_t begin = next_index.fetch_add(chunk_size, std::memory_order_relaxed); begin < num_tasks; begin = next_index.fetch_add(chunk_size, std::memory_order_relaxed)) {
+		const size_t end = std::min(begin + chunk_size, num_tasks);
+		for (size_t i = begin; i < end; i++) {
+			try {
+				task(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!error)
+					error = std::current_exception();
+			}
+		}
+	}
+}
@@ -0,0 +1,97 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_SLOTEXECUTOR_HPP
+#define INTAIRNET_LINKLAYER_GLUE_SLOTEXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Runs the nodes of a simulation through a time slot in parallel, on a fixed pool of threads.
+	 * A slot has two phases: every node transmits, then every node handles its receptions.
+	 * Each phase ends with a barrier, so within a phase, nodes may run concurrently as long as they share no mutable state.
+	 * E.g. the transmit phase calls IMac::update() and queues packets at a ReferenceChannel, the channel distributes them between the phases, and the receive phase passes them up through IPhy::onReception() and IMac::receiveFromLower().
+	 */
+	class SlotExecutor {
+	public:
+		/**
+		 * Starts 'num_threads - 1' workers; the calling thread takes part in every phase.
+		 * @param num_threads
+		 * @throws std::invalid_argument If 'num_threads' is zero.
+		 */
+		explicit SlotExecutor(size_t num_threads);
+
+		SlotExecutor(const SlotExecutor& other) = delete;
+		SlotExecutor& operator=(const SlotExecutor& other) = delete;
+
+		/** Stops and joins the workers. */
+		virtual ~SlotExecutor();
+
+		/**
+		 * Calls 'task' for every index in [0, num_tasks) on the pool, and returns once all calls have finished.
+		 * @param num_tasks
+		 * @param task Called concurrently for different indices.
+		 * @throws The first exception that any call threw, after all calls have finished.
+		 */
+		void forEach(size_t num_tasks, const std::function<void(size_t)>& task);
+
+		/**
+		 * Runs a time slot of 'num_nodes' nodes.
+		 * @param num_nodes
+		 * @param transmit Transmit phase of the node at an index.
+		 * @param exchange Called by a single thread between both phases, e.g. to distribute the sent packets; may be empty.
+		 * @param receive Receive phase of the node at an index.
+		 */
+		void runSlot(size_t num_nodes, const std::function<void(size_t)>& transmit, const std::function<void()>& exchange, const std::function<void(size_t)>& receive);
+
+		/** @return Number of threads that run a phase, including the calling thread. */
+		size_t getNumThreads() const;
+
+	protected:
+		/** Worker threads wait for the next phase, take part in it, and report back. */
+		void runWorker();
+
+		/** Claims chunks of indices of the current phase until none are left. */
+		void work();
+
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable phase_started;
+		std::condition_variable phase_finished;
+		/** Incremented with every phase, so that workers can tell a new phase from a spurious wakeup. */
+		uint64_t phase = 0;
+		bool is_stopping = false;
+		/** Number of workers that haven't finished the current phase. */
+		size_t num_busy = 0;
+		const std::function<void(size_t)>* task = nullptr;
+		size_t num_tasks = 0;
+		size_t chunk_size = 1;
+		std::atomic<size_t> next_index;
+		/** First exception thrown during the current phase. */
+		std::exception_ptr error;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_SLOTEXECUTOR_HPP
@@ -0,0 +1,96 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "SlotReservationBitmap.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	size_t getNumSlots(size_t horizon) {
+		size_t num_slots = 64;
+		while (num_slots < horizon)
+			num_slots <<= 1;
+		return num_slots;
+	}
+}
+
+SlotReservationBitmap::SlotReservationBitmap(size_t horizon) : words(getNumSlots(horizon) / 64, 0), mask(getNumSlots(horizon) - 1) {}
+
+template<typename Operation>
+bool SlotReservationBitmap::forEachWord(unsigned int slot_offset, unsigned int num_slots, Operation operation) const {
+	if ((size_t) slot_offset + num_slots > mask + 1)
+		throw std::out_of_range("SlotReservationBitmap range of " + std::to_string(num_slots) + " slots at offset " + std::to_string(slot_offset) + " exceeds the horizon of " + std::to_string(mask + 1) + " slots.");
+	size_t position = (origin + slot_offset) & mask;
+	size_t remaining = num_slots;
+	while (remaining > 0) {
+		const size_t first_bit = position % 64, num_bits = std::min(remaining, 64 - first_bit);
+		if (!operation(position / 64, getMask(first_bit, num_bits)))
+			return false;
+		remaining -= num_bits;
+		position = (position + num_bits) & mask;
+	}
+	return true;
+}
+
+void SlotReservationBitmap::reserve(unsigned int slot_offset, unsigned int num_slots) {
+	std::vector<uint64_t>& target = words;
+	forEachWord(slot_offset, num_slots, [&target](size_t index, uint64_t bits) {
+		target[index] |= bits;
+		return true;
+	});
+}
+
+void SlotReservationBitmap::release(unsigned int slot_offset, unsigned int num_slots) {
+	std::vector<uint64_t>& target = words;
+	forEachWord(slot_offset, num_slots, [&target](size_t index, uint64_t bits) {
+		target[index] &= ~bits;
+		return true;
+	});
+}
+
+bool SlotReservationBitmap::isIdleAcrossWords(unsigned int slot_offset, unsigned int num_slots) const {
+	const std::vector<uint64_t>& source = words;
+	return forEachWord(slot_offset, num_slots, [&source](size_t index, uint64_t bits) {
+		return (source[index] & bits) == 0;
+	});
+}
+
+bool SlotReservationBitmap::isReserved(unsigned int slot_offset) const {
+	return !isIdle(slot_offset, 1);
+}
+
+void SlotReservationBitmap::advance(uint64_t num_slots) {
+	if (num_slots > mask) {
+		clear();
+		origin = (origin + num_slots) & mask;
+		return;
+	}
+	// The slots that are now in the past become the end of the window and must be free.
+	release(0, (unsigned int) num_slots);
+	origin = (origin + num_slots) & mask;
+}
+
+void SlotReservationBitmap::clear() {
+	for (auto& word : words)
+		word = 0;
+}
+
+size_t SlotReservationBitmap::getHorizon() const {
+	return mask + 1;
+}
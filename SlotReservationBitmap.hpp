@@ -0,0 +1,109 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_SLOTRESERVATIONBITMAP_HPP
+#define INTAIRNET_LINKLAYER_GLUE_SLOTRESERVATIONBITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Marks which of the upcoming time slots are reserved, e.g. for a transmitter or a receiver.
+	 * Slots are addressed by their offset to the current slot, and one bit per slot is kept in a circular array of 64-bit words,
+	 * so that range queries and updates work on whole words and advancing in time only clears the slots that fall out of the window.
+	 */
+	class SlotReservationBitmap {
+	public:
+		/**
+		 * @param horizon Minimum number of slots from the current one on that can be reserved; rounded up to a power of two of at least 64.
+		 */
+		explicit SlotReservationBitmap(size_t horizon = 1024);
+
+		/**
+		 * @param slot_offset
+		 * @param num_slots
+		 * @throws std::out_of_range If the range exceeds the horizon.
+		 */
+		void reserve(unsigned int slot_offset, unsigned int num_slots = 1);
+
+		/**
+		 * @param slot_offset
+		 * @param num_slots
+		 * @throws std::out_of_range If the range exceeds the horizon.
+		 */
+		void release(unsigned int slot_offset, unsigned int num_slots = 1);
+
+		/**
+		 * @param slot_offset
+		 * @param num_slots
+		 * @return Whether none of the slots in the range is reserved.
+		 * @throws std::out_of_range If the range exceeds the horizon.
+		 */
+		bool isIdle(unsigned int slot_offset, unsigned int num_slots = 1) const {
+			// Most queried ranges lie within a single word, which takes a single mask test.
+			const size_t position = (origin + slot_offset) & mask, first_bit = position % 64;
+			if (first_bit + num_slots <= 64 && (size_t) slot_offset + num_slots <= mask + 1)
+				return (words[position / 64] & getMask(first_bit, num_slots)) == 0;
+			return isIdleAcrossWords(slot_offset, num_slots);
+		}
+
+		/**
+		 * @param slot_offset
+		 * @return Whether the slot is reserved.
+		 * @throws std::out_of_range If the offset exceeds the horizon.
+		 */
+		bool isReserved(unsigned int slot_offset) const;
+
+		/**
+		 * Moves the current slot forward. Reservations of slots that are now in the past are dropped.
+		 * @param num_slots
+		 */
+		void advance(uint64_t num_slots);
+
+		/** Releases all slots. */
+		void clear();
+
+		/** @return Number of slots that can be reserved, starting at the current one. */
+		size_t getHorizon() const;
+
+	protected:
+		/** @return Mask of 'num_bits' bits starting at 'first_bit', where first_bit + num_bits <= 64. */
+		static uint64_t getMask(size_t first_bit, size_t num_bits) {
+			const uint64_t bits = num_bits == 64 ? ~uint64_t(0) : (uint64_t(1) << num_bits) - 1;
+			return bits << first_bit;
+		}
+
+		bool isIdleAcrossWords(unsigned int slot_offset, unsigned int num_slots) const;
+
+		/**
+		 * Calls 'operation(word_index, mask)' for each word touched by the range, until it returns false.
+		 * @return Whether all calls returned true.
+		 */
+		template<typename Operation>
+		bool forEachWord(unsigned int slot_offset, unsigned int num_slots, Operation operation) const;
+
+		std::vector<uint64_t> words;
+		/** Number of slots minus one; the number of slots is a power of two. */
+		const size_t mask;
+		/** Bit position of the current slot. */
+		size_t origin = 0;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_SLOTRESERVATIONBITMAP_HPP
@@ -0,0 +1,270 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include "SpatialGrid.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+SpatialGrid::SpatialGrid(double cell_size) : cell_size(cell_size) {
+	if (!(cell_size > 0.0))
+		throw std::invalid_argument("SpatialGrid requires a positive cell size.");
+}
+
+int64_t SpatialGrid::toCellCoordinate(double value) const {
+	return (int64_t) std::floor(value / cell_size);
+}
+
+uint64_t SpatialGrid::toCellKey(int64_t cell_x, int64_t cell_y) {
+	return (uint64_t(uint32_t(cell_x)) << 32) | uint64_t(uint32_t(cell_y));
+}
+
+uint64_t SpatialGrid::getCellKey(const SimulatorPosition& position) const {
+	return toCellKey(toCellCoordinate(position.x), toCellCoordinate(position.y));
+}
+
+double SpatialGrid::getSquaredDistance(const SimulatorPosition& a, const SimulatorPosition& b) {
+	const double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+	return dx*dx + dy*dy + dz*dz;
+}
+
+const int32_t SpatialGrid::EMPTY_SLOT;
+
+size_t SpatialGrid::getHomeSlot(uint64_t key) const {
+	// Fibonacci hashing spreads neighboring cells over the table.
+	const uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+	return size_t(hash >> 32) & (cell_slots.size() - 1);
+}
+
+size_t SpatialGrid::probe(uint64_t key) const {
+	size_t slot = getHomeSlot(key);
+	while (cell_slots[slot] != EMPTY_SLOT && cells[cell_slots[slot]].key != key)
+		slot = (slot + 1) & (cell_slots.size() - 1);
+	return slot;
+}
+
+void SpatialGrid::rehash(size_t num_slots) {
+	cell_slots.assign(num_slots, EMPTY_SLOT);
+	for (size_t i = 0; i < cells.size(); i++)
+		cell_slots[probe(cells[i].key)] = (int32_t) i;
+}
+
+const SpatialGrid::Cell* SpatialGrid::findCell(int64_t cell_x, int64_t cell_y) const {
+	if (cells.empty())
+		return nullptr;
+	const size_t slot = probe(toCellKey(cell_x, cell_y));
+	return cell_slots[slot] == EMPTY_SLOT ? nullptr : &cells[cell_slots[slot]];
+}
+
+SpatialGrid::Cell& SpatialGrid::getOrAddCell(int64_t cell_x, int64_t cell_y) {
+	if (2 * (cells.size() + 1) > cell_slots.size())
+		rehash(cell_slots.empty() ? 16 : 2 * cell_slots.size());
+	const uint64_t key = toCellKey(cell_x, cell_y);
+	const size_t slot = probe(key);
+	if (cell_slots[slot] != EMPTY_SLOT)
+		return cells[cell_slots[slot]];
+	cell_slots[slot] = (int32_t) cells.size();
+	cells.push_back({key, cell_x, cell_y, {}});
+	return cells.back();
+}
+
+void SpatialGrid::eraseCell(uint64_t key) {
+	size_t slot = probe(key);
+	// Move the last cell into the erased one's place and point its slot there.
+	const int32_t index = cell_slots[slot];
+	const int32_t last = (int32_t) cells.size() - 1;
+	if (index != last) {
+		cell_slots[probe(cells[last].key)] = index;
+		cells[index] = std::move(cells[last]);
+	}
+	cells.pop_back();
+	// Backward-shift deletion, see NeighborPositionTable::erase().
+	const size_t mask = cell_slots.size() - 1;
+	size_t next = (slot + 1) & mask;
+	while (cell_slots[next] != EMPTY_SLOT) {
+		const size_t home = getHomeSlot(cells[cell_slots[next]].key);
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			cell_slots[slot] = cell_slots[next];
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+	cell_slots[slot] = EMPTY_SLOT;
+}
+
+void SpatialGrid::removeFromCell(const Location& location) {
+	std::vector<Item>& items = cells[cell_slots[probe(location.cell)]].items;
+	if (location.index + 1 != items.size()) {
+		items[location.index] = items.back();
+		locations[items[location.index].id].index = location.index;
+	}
+	items.pop_back();
+	if (items.empty())
+		eraseCell(location.cell);
+}
+
+void SpatialGrid::update(const MacId& id, const SimulatorPosition& position) {
+	const int64_t cell_x = toCellCoordinate(position.x), cell_y = toCellCoordinate(position.y);
+	const uint64_t cell = toCellKey(cell_x, cell_y);
+	auto location_it = locations.find(id.getId());
+	if (location_it != locations.end()) {
+		Location& location = location_it->second;
+		if (location.cell == cell) {
+			cells[cell_slots[probe(cell)]].items[location.index].position = position;
+			return;
+		}
+		const Location old_location = location;
+		removeFromCell(old_location);
+	}
+	std::vector<Item>& items = getOrAddCell(cell_x, cell_y).items;
+	items.push_back({id.getId(), position});
+	locations[id.getId()] = {cell, items.size() - 1};
+	if (max_cell_x < min_cell_x) {
+		min_cell_x = max_cell_x = cell_x;
+		min_cell_y = max_cell_y = cell_y;
+	} else {
+		min_cell_x = std::min(min_cell_x, cell_x);
+		max_cell_x = std::max(max_cell_x, cell_x);
+		min_cell_y = std::min(min_cell_y, cell_y);
+		max_cell_y = std::max(max_cell_y, cell_y);
+	}
+}
+
+bool SpatialGrid::erase(const MacId& id) {
+	auto location_it = locations.find(id.getId());
+	if (location_it == locations.end())
+		return false;
+	const Location location = location_it->second;
+	removeFromCell(location);
+	locations.erase(id.getId());
+	return true;
+}
+
+void SpatialGrid::clear() {
+	cells.clear();
+	cell_slots.clear();
+	locations.clear();
+	min_cell_x = min_cell_y = 0;
+	max_cell_x = max_cell_y = -1;
+}
+
+size_t SpatialGrid::size() const {
+	return locations.size();
+}
+
+double SpatialGrid::getCellSize() const {
+	return cell_size;
+}
+
+std::vector<MacId> SpatialGrid::neighborsWithin(const SimulatorPosition& center, double radius) const {
+	std::vector<MacId> neighbors;
+	if (locations.empty() || radius < 0.0)
+		return neighbors;
+	const double squared_radius = radius * radius;
+	const int64_t first_x = std::max(min_cell_x, toCellCoordinate(center.x - radius)), last_x = std::min(max_cell_x, toCellCoordinate(center.x + radius));
+	const int64_t first_y = std::max(min_cell_y, toCellCoordinate(center.y - radius)), last_y = std::min(max_cell_y, toCellCoordinate(center.y + radius));
+	if (first_x > last_x || first_y > last_y)
+		return neighbors;
+	auto check_cell = [&](const std::vector<Item>& items) {
+		for (const Item& item : items)
+			if (getSquaredDistance(item.position, center) <= squared_radius)
+				neighbors.emplace_back(item.id);
+	};
+	// For radii much larger than the cells, visiting the occupied cells is cheaper than visiting the covered ones.
+	const double num_covered_cells = double(last_x - first_x + 1) * double(last_y - first_y + 1);
+	if (num_covered_cells > double(cells.size())) {
+		for (const Cell& cell : cells)
+			if (cell.x >= first_x && cell.x <= last_x && cell.y >= first_y && cell.y <= last_y)
+				check_cell(cell.items);
+	} else {
+		for (int64_t x = first_x; x <= last_x; x++) {
+			for (int64_t y = first_y; y <= last_y; y++) {
+				const Cell* cell = findCell(x, y);
+				if (cell != nullptr)
+					check_cell(cell->items);
+			}
+		}
+	}
+	return neighbors;
+}
+
+std::vector<MacId> SpatialGrid::nearest(const SimulatorPosition& center, size_t k) const {
+	std::vector<MacId> result;
+	if (k == 0 || locations.empty())
+		return result;
+	// Max-heap of the k closest users found so far.
+	std::priority_queue<std::pair<double, int>> closest;
+	const int64_t center_x = toCellCoordinate(center.x), center_y = toCellCoordinate(center.y);
+	const int64_t max_ring = std::max(std::max(std::abs(center_x - min_cell_x), std::abs(max_cell_x - center_x)), std::max(std::abs(center_y - min_cell_y), std::abs(max_cell_y - center_y)));
+	size_t num_visited = 0;
+	auto visit_cell = [&](const Cell& cell) {
+		for (const Item& item : cell.items) {
+			num_visited++;
+			const double squared_distance = getSquaredDistance(item.position, center);
+			if (closest.size() < k)
+				closest.emplace(squared_distance, item.id);
+			else if (squared_distance < closest.top().first) {
+				closest.pop();
+				closest.emplace(squared_distance, item.id);
+			}
+		}
+	};
+	// Ring cells outside the bounding box of occupied cells can be skipped without a lookup.
+	auto visit = [&](int64_t x, int64_t y) {
+		if (x < min_cell_x || x > max_cell_x || y < min_cell_y || y > max_cell_y)
+			return;
+		const Cell* cell = findCell(x, y);
+		if (cell != nullptr)
+			visit_cell(*cell);
+	};
+	// Visit rings of cells around the center until no unvisited cell can hold a closer user.
+	for (int64_t ring = 0; ring <= max_ring && num_visited < locations.size(); ring++) {
+		if (ring > 0 && size_t(8 * ring) > cells.size()) {
+			// Rings now have more cells than are occupied, so scan all remaining occupied cells instead.
+			for (const Cell& cell : cells)
+				if (std::max(std::abs(cell.x - center_x), std::abs(cell.y - center_y)) >= ring)
+					visit_cell(cell);
+			break;
+		}
+		if (ring == 0)
+			visit(center_x, center_y);
+		else {
+			for (int64_t x = center_x - ring; x <= center_x + ring; x++) {
+				visit(x, center_y - ring);
+				visit(x, center_y + ring);
+			}
+			for (int64_t y = center_y - ring + 1; y <= center_y + ring - 1; y++) {
+				visit(center_x - ring, y);
+				visit(center_x + ring, y);
+			}
+		}
+		// Cells outside the visited rings are at least 'ring' cells away horizontally.
+		const double unvisited_distance = double(ring) * cell_size;
+		if (closest.size() == k && closest.top().first <= unvisited_distance * unvisited_distance)
+			break;
+	}
+	result.reserve(closest.size());
+	while (!closest.empty()) {
+		result.emplace_back(closest.top().second);
+		closest.pop();
+	}
+	std::reverse(result.begin(), result.end());
+	return result;
+}
@@ -0,0 +1,139 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_SPATIALGRID_HPP
+#define INTAIRNET_LINKLAYER_GLUE_SPATIALGRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "MacId.hpp"
+#include "SimulatorPosition.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Uniform grid over the horizontal (x, y) plane that answers range and nearest-neighbor queries over user positions.
+	 * Distances are Euclidean in all three dimensions; the grid only partitions the horizontal plane, as the altitude span is small compared to communication ranges.
+	 * Positions are updated incrementally: moving a user only touches its old and new cells.
+	 */
+	class SpatialGrid {
+	public:
+		/**
+		 * @param cell_size Edge length of a grid cell, in the unit of SimulatorPosition. Queries are fastest when it's in the order of typical query radii.
+		 * @throws std::invalid_argument If 'cell_size' is not positive.
+		 */
+		explicit SpatialGrid(double cell_size = 50000.0);
+
+		/**
+		 * Inserts the user or moves it to its new position.
+		 * @param id
+		 * @param position
+		 */
+		void update(const MacId& id, const SimulatorPosition& position);
+
+		/**
+		 * @param id
+		 * @return Whether the user was known.
+		 */
+		bool erase(const MacId& id);
+
+		void clear();
+
+		size_t size() const;
+
+		/**
+		 * @param center
+		 * @param radius
+		 * @return All users within 'radius' of 'center', in no particular order.
+		 */
+		std::vector<MacId> neighborsWithin(const SimulatorPosition& center, double radius) const;
+
+		/**
+		 * @param center
+		 * @param k
+		 * @return The (up to) k users closest to 'center', closest first.
+		 */
+		std::vector<MacId> nearest(const SimulatorPosition& center, size_t k) const;
+
+		double getCellSize() const;
+
+		/** @return The squared Euclidean distance in all three dimensions, which the queries compare. */
+		static double getSquaredDistance(const SimulatorPosition& a, const SimulatorPosition& b);
+
+	protected:
+		struct Item {
+			int id;
+			SimulatorPosition position;
+		};
+
+		/** An occupied cell and its users. */
+		struct Cell {
+			uint64_t key;
+			int64_t x, y;
+			std::vector<Item> items;
+		};
+
+		/** Where a user is stored. */
+		struct Location {
+			uint64_t cell;
+			size_t index;
+		};
+
+		int64_t toCellCoordinate(double value) const;
+
+		static uint64_t toCellKey(int64_t cell_x, int64_t cell_y);
+
+		uint64_t getCellKey(const SimulatorPosition& position) const;
+
+		/** Removes the item at 'location' from its cell, filling the gap with the cell's last item. Removes the cell once it's empty. */
+		void removeFromCell(const Location& location);
+
+		/** @return The occupied cell, or nullptr. */
+		const Cell* findCell(int64_t cell_x, int64_t cell_y) const;
+
+		/** @return The occupied cell, which is added if needed. */
+		Cell& getOrAddCell(int64_t cell_x, int64_t cell_y);
+
+		/** Removes an occupied cell. The last cell takes its place. */
+		void eraseCell(uint64_t key);
+
+		/** @return Index into 'cell_slots' where the search for 'key' starts. */
+		size_t getHomeSlot(uint64_t key) const;
+
+		/** @return Index into 'cell_slots' that holds 'key', or the empty slot where it would be inserted. */
+		size_t probe(uint64_t key) const;
+
+		/** Rebuilds the index with 'num_slots' slots, which must be a power of two. */
+		void rehash(size_t num_slots);
+
+	protected:
+		const double cell_size;
+		/** Marks an unused slot. */
+		static const int32_t EMPTY_SLOT = -1;
+		/** All occupied cells, stored contiguously. */
+		std::vector<Cell> cells;
+		/** Open-addressing index with linear probing, as in NeighborPositionTable, so that queries visiting many cells don't pay for std::unordered_map lookups. Each slot holds an index into 'cells' or EMPTY_SLOT. At most half of the slots are used. */
+		std::vector<int32_t> cell_slots;
+		/** Where each user is stored. */
+		std::unordered_map<int, Location> locations;
+		/** Bounding box of all cells that were ever occupied, which bounds range queries. */
+		int64_t min_cell_x = 0, max_cell_x = -1, min_cell_y = 0, max_cell_y = -1;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_SPATIALGRID_HPP
@@ -18,7 +18,7 @@
 
 using namespace TUHH_INTAIRNET_MCSOTDMA;
 
-Statistic::Statistic(const std::string& name, IOmnetPluggable *creator) : name(name), value(0.0), was_updated(false), creator(creator) {}
+Statistic::Statistic(const std::string& name, IOmnetPluggable *creator) : name(name), handle(creator != nullptr ? creator->registerSignal(name) : 0), value(0.0), was_updated(false), creator(creator) {}
 
 void Statistic::capture(double new_value) {	
 	this->value = new_value;
@@ -28,7 +28,7 @@ void Statistic::capture(double new_value) {
 void Statistic::update() {
 	// Only emit to the simulator if the value has changed.
 	if (was_updated || !has_emitted_once) {		
-		creator->emit(name, value);
+		creator->emit(handle, value);
 		was_updated = false;
 		has_emitted_once = true;
 	}
@@ -33,7 +33,7 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 		void increment();
 		void incrementBy(double incr_val);
 
-		/** Called after every slot. Emits the value to the simulator if it has been changed. */
+		/** Called after every slot. Emits the value to the simulator if it has been changed. If the creator batches emissions, call its flushEmissions() once all statistics have been updated. */
 		void update();
 
 		double get() const;
@@ -45,6 +45,8 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 
 	protected:
 		const std::string name;
+		/** Interned 'name', so that emission doesn't copy the string. */
+		const IOmnetPluggable::SignalHandle handle;
 		double value;
 		bool was_updated;
 		bool has_emitted_once = false;
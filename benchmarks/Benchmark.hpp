@@ -0,0 +1,380 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_BENCHMARK_HPP
+#define INTAIRNET_LINKLAYER_GLUE_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+	namespace benchmark {
+
+		/**
+		 * Prevents the compiler from optimizing away the computation of 'value'.
+		 * @param value
+		 */
+		template <typename T>
+		inline void doNotOptimize(const T& value) {
+			asm volatile("" : : "r,m"(value) : "memory");
+		}
+
+		/**
+		 * Passed to every benchmark function, which runs its measured code once per iteration:
+		 * while (state.keepRunning()) { ... }
+		 */
+		class State {
+		public:
+			State(uint64_t max_iterations, const std::vector<int64_t>& args) : max_iterations(max_iterations), args(args) {}
+
+			/**
+			 * Starts the timer on the first call and stops it after the last iteration.
+			 * @return Whether another iteration should be run.
+			 */
+			bool keepRunning() {
+				if (num_iterations == 0)
+					resumeTiming();
+				if (num_iterations < max_iterations) {
+					num_iterations++;
+					return true;
+				}
+				pauseTiming();
+				return false;
+			}
+
+			/** Excludes the following code from the measurement, e.g. to set up the next iteration. */
+			void pauseTiming() {
+				if (!running)
+					return;
+				real_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - real_start).count();
+				cpu_seconds += double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+				running = false;
+			}
+
+			void resumeTiming() {
+				if (running)
+					return;
+				real_start = std::chrono::steady_clock::now();
+				cpu_start = std::clock();
+				running = true;
+			}
+
+			/**
+			 * @param index
+			 * @return The benchmark argument at 'index', e.g. the number of messages.
+			 * @throws std::out_of_range If the benchmark has fewer arguments.
+			 */
+			int64_t range(size_t index = 0) const {
+				return args.at(index);
+			}
+
+			/** Reports the number of processed items, which adds a throughput to the results. */
+			void setItemsProcessed(int64_t items) {
+				this->items_processed = items;
+			}
+
+			uint64_t iterations() const {
+				return num_iterations;
+			}
+
+			double getRealSeconds() const {
+				return real_seconds;
+			}
+
+			double getCpuSeconds() const {
+				return cpu_seconds;
+			}
+
+			int64_t getItemsProcessed() const {
+				return items_processed;
+			}
+
+		protected:
+			const uint64_t max_iterations;
+			const std::vector<int64_t> args;
+			uint64_t num_iterations = 0;
+			int64_t items_processed = 0;
+			bool running = false;
+			double real_seconds = 0.0, cpu_seconds = 0.0;
+			std::chrono::steady_clock::time_point real_start;
+			std::clock_t cpu_start = 0;
+		};
+
+		/**
+		 * A registered benchmark function with the argument sets it is run for.
+		 */
+		class Benchmark {
+		public:
+			Benchmark(std::string name, std::function<void(State&)> function) : name(std::move(name)), function(std::move(function)) {}
+
+			/** Adds a run with a single argument. */
+			Benchmark* arg(int64_t value) {
+				arg_sets.push_back({value});
+				return this;
+			}
+
+			/** Adds a run with several arguments. */
+			Benchmark* args(const std::vector<int64_t>& values) {
+				arg_sets.push_back(values);
+				return this;
+			}
+
+			/** Adds single-argument runs for 'first', 'first'*'multiplier', ..., up to 'last'. */
+			Benchmark* range(int64_t first, int64_t last, int64_t multiplier = 8) {
+				for (int64_t value = first; value < last; value *= multiplier)
+					arg(value);
+				return arg(last);
+			}
+
+			/** Names the arguments in the reported run names, e.g. "L2Packet_build/messages:4". */
+			Benchmark* argNames(const std::vector<std::string>& names) {
+				arg_names = names;
+				return this;
+			}
+
+			const std::string& getName() const {
+				return name;
+			}
+
+			/** @return One name per argument set. */
+			std::vector<std::string> getRunNames() const {
+				std::vector<std::string> run_names;
+				if (arg_sets.empty())
+					run_names.push_back(name);
+				for (const auto& arg_set : arg_sets) {
+					std::string run_name = name;
+					for (size_t i = 0; i < arg_set.size(); i++)
+						run_name += "/" + (i < arg_names.size() ? arg_names.at(i) + ":" : "") + std::to_string(arg_set.at(i));
+					run_names.push_back(run_name);
+				}
+				return run_names;
+			}
+
+			std::vector<std::vector<int64_t>> getArgSets() const {
+				return arg_sets.empty() ? std::vector<std::vector<int64_t>>(1) : arg_sets;
+			}
+
+			void run(State& state) const {
+				function(state);
+			}
+
+		protected:
+			const std::string name;
+			const std::function<void(State&)> function;
+			std::vector<std::vector<int64_t>> arg_sets;
+			std::vector<std::string> arg_names;
+		};
+
+		/** Holds all benchmarks registered through GLUE_BENCHMARK. */
+		class Registry {
+		public:
+			static std::vector<std::unique_ptr<Benchmark>>& getBenchmarks() {
+				static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+				return benchmarks;
+			}
+
+			static Benchmark* add(const std::string& name, std::function<void(State&)> function) {
+				getBenchmarks().emplace_back(new Benchmark(name, std::move(function)));
+				return getBenchmarks().back().get();
+			}
+		};
+
+		/** Measurement of one argument set of one benchmark. */
+		struct Result {
+			std::string name;
+			uint64_t iterations = 0;
+			double real_time_ns = 0.0, cpu_time_ns = 0.0;
+			double items_per_second = 0.0;
+		};
+
+		/**
+		 * Runs 'benchmark' with 'arg_set', increasing the number of iterations until the measurement takes at least 'min_time' seconds.
+		 */
+		inline Result measure(const Benchmark& benchmark, const std::string& run_name, const std::vector<int64_t>& arg_set, double min_time) {
+			const uint64_t max_iterations = 1000000000;
+			uint64_t iterations = 1;
+			while (true) {
+				State state = State(iterations, arg_set);
+				benchmark.run(state);
+				if (state.getRealSeconds() >= min_time || iterations >= max_iterations) {
+					Result result;
+					result.name = run_name;
+					result.iterations = state.iterations();
+					result.real_time_ns = state.getRealSeconds() * 1e9 / std::max<uint64_t>(1, state.iterations());
+					result.cpu_time_ns = state.getCpuSeconds() * 1e9 / std::max<uint64_t>(1, state.iterations());
+					if (state.getItemsProcessed() > 0 && state.getRealSeconds() > 0)
+						result.items_per_second = state.getItemsProcessed() / state.getRealSeconds();
+					return result;
+				}
+				// Aim slightly above the minimum time, but grow by at most 10x per round.
+				double multiplier = min_time * 1.4 / std::max(state.getRealSeconds(), 1e-9);
+				multiplier = std::min(10.0, std::max(2.0, multiplier));
+				iterations = std::min(max_iterations, (uint64_t) (iterations * multiplier));
+			}
+		}
+
+		inline std::string escapeJson(const std::string& value) {
+			std::string escaped;
+			for (char c : value) {
+				if (c == '"' || c == '\\')
+					escaped += '\\';
+				escaped += c;
+			}
+			return escaped;
+		}
+
+		/**
+		 * Writes results in the JSON layout of Google Benchmark, so that existing tooling can compare runs.
+		 */
+		inline void writeJson(std::ostream& out, const std::string& executable, const std::vector<Result>& results) {
+			std::time_t now = std::time(nullptr);
+			char date[32];
+			std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+			out << "{\n  \"context\": {\n";
+			out << "    \"date\": \"" << date << "\",\n";
+			out << "    \"executable\": \"" << escapeJson(executable) << "\",\n";
+			out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+			out << "    \"library_build_type\": \"release\"\n";
+#else
+			out << "    \"library_build_type\": \"debug\"\n";
+#endif
+			out << "  },\n  \"benchmarks\": [\n";
+			out << std::setprecision(10);
+			for (size_t i = 0; i < results.size(); i++) {
+				const Result& result = results.at(i);
+				out << "    {\n";
+				out << "      \"name\": \"" << escapeJson(result.name) << "\",\n";
+				out << "      \"run_name\": \"" << escapeJson(result.name) << "\",\n";
+				out << "      \"run_type\": \"iteration\",\n";
+				out << "      \"iterations\": " << result.iterations << ",\n";
+				out << "      \"real_time\": " << result.real_time_ns << ",\n";
+				out << "      \"cpu_time\": " << result.cpu_time_ns << ",\n";
+				if (result.items_per_second > 0)
+					out << "      \"items_per_second\": " << result.items_per_second << ",\n";
+				out << "      \"time_unit\": \"ns\"\n";
+				out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+			}
+			out << "  ]\n}\n";
+		}
+
+		inline void writeConsole(std::ostream& out, const Result& result) {
+			out << std::left << std::setw(56) << result.name << std::right << std::fixed << std::setprecision(1)
+				<< std::setw(14) << result.real_time_ns << " ns"
+				<< std::setw(14) << result.cpu_time_ns << " ns"
+				<< std::setw(12) << result.iterations;
+			if (result.items_per_second > 0)
+				out << std::setw(14) << std::setprecision(3) << std::scientific << result.items_per_second << " items/s";
+			out << std::defaultfloat << std::endl;
+		}
+
+		/**
+		 * Runs all registered benchmarks. Understands the Google Benchmark flags
+		 * --benchmark_filter=<regex>, --benchmark_min_time=<seconds>, --benchmark_format=<console|json>, --benchmark_out=<file> and --benchmark_list_tests.
+		 * @return Process exit code.
+		 */
+		inline int runSpecifiedBenchmarks(int argc, char** argv) {
+			std::string filter = ".*", format = "console", out_file;
+			double min_time = 0.1;
+			bool list_only = false;
+			for (int i = 1; i < argc; i++) {
+				const std::string arg = argv[i];
+				auto value_of = [&arg](const std::string& flag) { return arg.substr(flag.size()); };
+				try {
+					if (arg.find("--benchmark_filter=") == 0)
+						filter = value_of("--benchmark_filter=");
+					else if (arg.find("--benchmark_min_time=") == 0)
+						min_time = std::stod(value_of("--benchmark_min_time="));
+					else if (arg.find("--benchmark_format=") == 0)
+						format = value_of("--benchmark_format=");
+					else if (arg.find("--benchmark_out=") == 0)
+						out_file = value_of("--benchmark_out=");
+					else if (arg == "--benchmark_list_tests")
+						list_only = true;
+					else
+						throw std::invalid_argument("unknown flag");
+				} catch (const std::exception& e) {
+					std::cerr << "Invalid argument '" << arg << "': " << e.what() << std::endl;
+					return 1;
+				}
+			}
+			if (format != "console" && format != "json") {
+				std::cerr << "Unknown --benchmark_format '" << format << "'." << std::endl;
+				return 1;
+			}
+			std::regex filter_regex;
+			try {
+				filter_regex = std::regex(filter);
+			} catch (const std::regex_error& e) {
+				std::cerr << "Invalid --benchmark_filter '" << filter << "': " << e.what() << std::endl;
+				return 1;
+			}
+
+			std::vector<Result> results;
+			if (format == "console" && !list_only)
+				std::cout << std::left << std::setw(56) << "Benchmark" << std::right << std::setw(17) << "Time" << std::setw(17) << "CPU" << std::setw(12) << "Iterations" << std::endl;
+			for (const auto& benchmark : Registry::getBenchmarks()) {
+				const auto run_names = benchmark->getRunNames();
+				const auto arg_sets = benchmark->getArgSets();
+				for (size_t i = 0; i < run_names.size(); i++) {
+					if (!std::regex_search(run_names.at(i), filter_regex))
+						continue;
+					if (list_only) {
+						std::cout << run_names.at(i) << std::endl;
+						continue;
+					}
+					results.push_back(measure(*benchmark, run_names.at(i), arg_sets.at(i), min_time));
+					if (format == "console")
+						writeConsole(std::cout, results.back());
+				}
+			}
+			if (list_only)
+				return 0;
+			if (format == "json")
+				writeJson(std::cout, argv[0], results);
+			if (!out_file.empty()) {
+				std::ofstream out = std::ofstream(out_file);
+				if (!out) {
+					std::cerr << "Cannot write to '" << out_file << "'." << std::endl;
+					return 1;
+				}
+				writeJson(out, argv[0], results);
+			}
+			return 0;
+		}
+	}
+}
+
+/**
+ * Registers a benchmark function void(benchmark::State&). Argument sets can be chained, e.g. GLUE_BENCHMARK(f)->range(1, 64).
+ */
+#define GLUE_BENCHMARK(function) \
+	static ::TUHH_INTAIRNET_MCSOTDMA::benchmark::Benchmark* glue_benchmark_##function = ::TUHH_INTAIRNET_MCSOTDMA::benchmark::Registry::add(#function, function)
+
+#endif //INTAIRNET_LINKLAYER_GLUE_BENCHMARK_HPP
@@ -0,0 +1,130 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Benchmark.hpp"
+#include "../L2Packet.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	class BenchmarkPayload : public L2Packet::Payload {
+	public:
+		explicit BenchmarkPayload(unsigned int bits) : bits(bits) {}
+
+		unsigned int getBits() const override {
+			return bits;
+		}
+
+		Payload* copy() const override {
+			return new BenchmarkPayload(bits);
+		}
+
+	protected:
+		unsigned int bits;
+	};
+
+	/** A broadcast header followed by num_messages-1 unicast messages. */
+	L2Packet* buildPacket(int64_t num_messages) {
+		auto* packet = new L2Packet();
+		packet->addMessage(new L2HeaderSH(MacId(1)), new BenchmarkPayload(128));
+		for (int64_t i = 1; i < num_messages; i++)
+			packet->addMessage(new L2HeaderPP(MacId(1), MacId(2)), new BenchmarkPayload(512));
+		return packet;
+	}
+
+	void L2Packet_build(benchmark::State& state) {
+		while (state.keepRunning()) {
+			L2Packet* packet = buildPacket(state.range(0));
+			benchmark::doNotOptimize(packet);
+			state.pauseTiming();
+			delete packet;
+			state.resumeTiming();
+		}
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void L2Packet_copy(benchmark::State& state) {
+		std::unique_ptr<L2Packet> packet = std::unique_ptr<L2Packet>(buildPacket(state.range(0)));
+		while (state.keepRunning()) {
+			std::unique_ptr<L2Packet> clone = packet->clone();
+			benchmark::doNotOptimize(clone);
+			state.pauseTiming();
+			clone.reset();
+			state.resumeTiming();
+		}
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void L2Packet_destroy(benchmark::State& state) {
+		while (state.keepRunning()) {
+			state.pauseTiming();
+			L2Packet* packet = buildPacket(state.range(0));
+			state.resumeTiming();
+			delete packet;
+		}
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/** Argument is the number of link utilizations, proposals and requests each. */
+	void L2HeaderSH_copy(benchmark::State& state) {
+		L2HeaderSH header = L2HeaderSH(MacId(1));
+		for (int64_t i = 0; i < state.range(0); i++) {
+			header.link_utilizations.emplace_back((int) i, SlotDuration::twentyfour_ms);
+			header.link_proposals.emplace_back();
+			header.link_requests.emplace_back(MacId(2), LinkProposal());
+		}
+		while (state.keepRunning()) {
+			L2Header* copy = header.copy();
+			benchmark::doNotOptimize(copy);
+			delete copy;
+		}
+	}
+
+	void L2Packet_getBits(benchmark::State& state) {
+		std::unique_ptr<L2Packet> packet = std::unique_ptr<L2Packet>(buildPacket(state.range(0)));
+		while (state.keepRunning())
+			benchmark::doNotOptimize(packet->getBits());
+	}
+
+	/** Measures getBits() when the SH changes in between, so that the cached size must be recomputed. */
+	void L2Packet_getBits_afterChange(benchmark::State& state) {
+		std::unique_ptr<L2Packet> packet = std::unique_ptr<L2Packet>(buildPacket(state.range(0)));
+		auto* header = (L2HeaderSH*) packet->getHeaders().at(0);
+		while (state.keepRunning()) {
+			header->link_requests.emplace_back(MacId(2), LinkProposal());
+			benchmark::doNotOptimize(packet->getBits());
+			header->link_requests.clear();
+		}
+	}
+
+	/** The destination is found after num_messages-1 headers without one. */
+	void L2Packet_getDestination(benchmark::State& state) {
+		L2Packet packet;
+		for (int64_t i = 1; i < state.range(0); i++)
+			packet.addMessage(new L2Header(L2Header::FrameType::base), nullptr);
+		packet.addMessage(new L2HeaderPP(MacId(1), MacId(2)), new BenchmarkPayload(512));
+		while (state.keepRunning())
+			benchmark::doNotOptimize(packet.getDestination());
+	}
+}
+
+GLUE_BENCHMARK(L2Packet_build)->range(1, 64)->argNames({"messages"});
+GLUE_BENCHMARK(L2Packet_copy)->range(1, 64)->argNames({"messages"});
+GLUE_BENCHMARK(L2Packet_destroy)->range(1, 64)->argNames({"messages"});
+GLUE_BENCHMARK(L2HeaderSH_copy)->arg(0)->arg(4)->arg(15)->argNames({"link_messages"});
+GLUE_BENCHMARK(L2Packet_getBits)->range(1, 64)->argNames({"messages"});
+GLUE_BENCHMARK(L2Packet_getBits_afterChange)->range(1, 64)->argNames({"messages"});
+GLUE_BENCHMARK(L2Packet_getDestination)->range(1, 64)->argNames({"messages"});
@@ -0,0 +1,192 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Benchmark.hpp"
+#include "../IMac.hpp"
+#include "../Statistic.hpp"
+#include <random>
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	class BenchmarkMac : public IMac {
+	public:
+		explicit BenchmarkMac(const MacId& id) : IMac(id) {}
+
+		void notifyOutgoing(unsigned long, const MacId&) override {}
+
+		void passToLower(L2Packet*, unsigned int) override {}
+
+		void receiveFromLower(L2Packet*, uint64_t) override {}
+
+		void passToUpper(L2Packet*) override {}
+
+		bool isGoingToTransmitDuringCurrentSlot(uint64_t) const override {
+			return false;
+		}
+
+		void setSilent(bool) override {}
+	};
+
+	/** A MAC that knows the positions of 'fleet_size' neighbors, spread over 400x400 km. */
+	std::unique_ptr<BenchmarkMac> buildMac(int64_t fleet_size) {
+		std::unique_ptr<BenchmarkMac> mac = std::unique_ptr<BenchmarkMac>(new BenchmarkMac(MacId(0)));
+		std::mt19937 generator = std::mt19937(1);
+		std::uniform_real_distribution<double> horizontal = std::uniform_real_distribution<double>(-200000.0, 200000.0);
+		for (int64_t i = 1; i <= fleet_size; i++)
+			mac->updatePosition(MacId((int) i), CPRPosition(SimulatorPosition(horizontal(generator), horizontal(generator), 10000.0)), CPRPosition::PositionQuality::hi);
+		return mac;
+	}
+
+	void IMac_getPosition(benchmark::State& state) {
+		auto mac = buildMac(state.range(0));
+		int id = 1;
+		while (state.keepRunning()) {
+			benchmark::doNotOptimize(mac->getPosition(MacId(id)));
+			id = id == state.range(0) ? 1 : id + 1;
+		}
+	}
+
+	/** Looks up IDs of which half are unknown. */
+	void IMac_findPosition(benchmark::State& state) {
+		auto mac = buildMac(state.range(0));
+		int id = 1;
+		while (state.keepRunning()) {
+			benchmark::doNotOptimize(mac->findPosition(MacId(id)));
+			id = id == 2 * state.range(0) ? 1 : id + 1;
+		}
+	}
+
+	void IMac_updatePosition(benchmark::State& state) {
+		auto mac = buildMac(state.range(0));
+		const CPRPosition position = CPRPosition(1, 2, 3, true);
+		int id = 1;
+		while (state.keepRunning()) {
+			mac->updatePosition(MacId(id), position, CPRPosition::PositionQuality::med);
+			id = id == state.range(0) ? 1 : id + 1;
+		}
+	}
+
+	/** Neighbors within 50 km, e.g. to find slot-reuse candidates. */
+	void IMac_getNeighborsWithin(benchmark::State& state) {
+		auto mac = buildMac(state.range(0));
+		while (state.keepRunning())
+			benchmark::doNotOptimize(mac->getNeighborsWithin(50000.0));
+	}
+
+	/** The same query as a linear scan over all neighbors, for comparison. */
+	void IMac_getNeighborsWithin_linearScan(benchmark::State& state) {
+		auto mac = buildMac(state.range(0));
+		while (state.keepRunning()) {
+			std::vector<MacId> neighbors;
+			const SimulatorPosition& own = mac->getPosition(mac->getMacId()).encodedPosition;
+			for (const auto& entry : mac->getNeighborPositions()) {
+				const SimulatorPosition& other = entry.position.encodedPosition;
+				const double dx = other.x - own.x, dy = other.y - own.y, dz = other.z - own.z;
+				if (entry.id != mac->getMacId().getId() && dx*dx + dy*dy + dz*dz <= 50000.0 * 50000.0)
+					neighbors.push_back(entry.getMacId());
+			}
+			benchmark::doNotOptimize(neighbors);
+		}
+	}
+
+	void IMac_getNearestNeighbors(benchmark::State& state) {
+		auto mac = buildMac(state.range(0));
+		while (state.keepRunning())
+			benchmark::doNotOptimize(mac->getNearestNeighbors(8));
+	}
+
+	/** Argument is the number of statistics that are captured and updated per slot. */
+	void Statistic_update(benchmark::State& state) {
+		IOmnetPluggable pluggable;
+		double sum = 0.0;
+		pluggable.emitCallback = [&sum](const std::string&, double value) { sum += value; };
+		std::vector<std::unique_ptr<Statistic>> statistics;
+		for (int64_t i = 0; i < state.range(0); i++)
+			statistics.emplace_back(new Statistic("mcsotdma_statistic_" + std::to_string(i), &pluggable));
+		while (state.keepRunning()) {
+			for (auto& statistic : statistics) {
+				statistic->increment();
+				statistic->update();
+			}
+		}
+		benchmark::doNotOptimize(sum);
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/** Like Statistic_update, but with one batch callback per slot instead of one callback per statistic. */
+	void Statistic_update_batched(benchmark::State& state) {
+		IOmnetPluggable pluggable;
+		double sum = 0.0;
+		pluggable.emitBatchCallback = [&sum](const IOmnetPluggable::SignalEmission* emissions, size_t num) {
+			for (size_t i = 0; i < num; i++)
+				sum += emissions[i].value;
+		};
+		std::vector<std::unique_ptr<Statistic>> statistics;
+		for (int64_t i = 0; i < state.range(0); i++)
+			statistics.emplace_back(new Statistic("mcsotdma_statistic_" + std::to_string(i), &pluggable));
+		while (state.keepRunning()) {
+			for (auto& statistic : statistics) {
+				statistic->increment();
+				statistic->update();
+			}
+			pluggable.flushEmissions();
+		}
+		benchmark::doNotOptimize(sum);
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	class SummingSink : public IOmnetSink {
+	public:
+		double getTime() override {
+			return 0.0;
+		}
+
+		void emit(SignalHandle, double value) override {
+			sum += value;
+		}
+
+		double sum = 0.0;
+	};
+
+	/** Like Statistic_update, but emitting through an IOmnetSink. */
+	void Statistic_update_sink(benchmark::State& state) {
+		IOmnetPluggable pluggable;
+		SummingSink sink;
+		pluggable.setSink(&sink);
+		std::vector<std::unique_ptr<Statistic>> statistics;
+		for (int64_t i = 0; i < state.range(0); i++)
+			statistics.emplace_back(new Statistic("mcsotdma_statistic_" + std::to_string(i), &pluggable));
+		while (state.keepRunning()) {
+			for (auto& statistic : statistics) {
+				statistic->increment();
+				statistic->update();
+			}
+		}
+		benchmark::doNotOptimize(sink.sum);
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+}
+
+GLUE_BENCHMARK(IMac_getPosition)->range(1, 512)->argNames({"fleet"});
+GLUE_BENCHMARK(IMac_findPosition)->range(1, 512)->argNames({"fleet"});
+GLUE_BENCHMARK(IMac_updatePosition)->range(1, 512)->argNames({"fleet"});
+GLUE_BENCHMARK(IMac_getNeighborsWithin)->range(8, 4096)->argNames({"fleet"});
+GLUE_BENCHMARK(IMac_getNeighborsWithin_linearScan)->range(8, 4096)->argNames({"fleet"});
+GLUE_BENCHMARK(IMac_getNearestNeighbors)->range(8, 4096)->argNames({"fleet"});
+GLUE_BENCHMARK(Statistic_update)->range(1, 64)->argNames({"statistics"});
+GLUE_BENCHMARK(Statistic_update_batched)->range(1, 64)->argNames({"statistics"});
+GLUE_BENCHMARK(Statistic_update_sink)->range(1, 64)->argNames({"statistics"});
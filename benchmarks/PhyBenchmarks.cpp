@@ -0,0 +1,176 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <memory>
+#include <random>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../SlotReservationBitmap.hpp"
+#include "../ReferenceChannel.hpp"
+#include "../ReservationPhy.hpp"
+#include "../InetPacketPayload.hpp"
+#include "../DelayMac.hpp"
+#include "../PassThroughArq.hpp"
+#include "../PassThroughRlc.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	/** Argument is the length of the queried slot range. Queries every offset of the horizon, like a MAC evaluating candidate slots. */
+	void SlotReservationBitmap_isIdle(benchmark::State& state) {
+		SlotReservationBitmap bitmap = SlotReservationBitmap(1024);
+		for (unsigned int offset = 0; offset < 1024; offset += 97)
+			bitmap.reserve(offset);
+		const unsigned int num_slots = (unsigned int) state.range(0);
+		while (state.keepRunning()) {
+			size_t num_idle = 0;
+			for (unsigned int offset = 0; offset + num_slots <= 1024; offset++)
+				num_idle += bitmap.isIdle(offset, num_slots);
+			benchmark::doNotOptimize(num_idle);
+		}
+		state.setItemsProcessed(state.iterations() * (1024 - num_slots + 1));
+	}
+
+	/** Same queries, answered by a per-slot loop over one flag per slot. */
+	void SlotReservationBitmap_isIdle_perSlotLoop(benchmark::State& state) {
+		std::vector<bool> reserved = std::vector<bool>(1024, false);
+		for (unsigned int offset = 0; offset < 1024; offset += 97)
+			reserved[offset] = true;
+		const unsigned int num_slots = (unsigned int) state.range(0);
+		while (state.keepRunning()) {
+			size_t num_idle = 0;
+			for (unsigned int offset = 0; offset + num_slots <= 1024; offset++) {
+				bool idle = true;
+				for (unsigned int slot = offset; slot < offset + num_slots && idle; slot++)
+					idle = !reserved[slot];
+				num_idle += idle;
+			}
+			benchmark::doNotOptimize(num_idle);
+		}
+		state.setItemsProcessed(state.iterations() * (1024 - num_slots + 1));
+	}
+}
+
+namespace {
+	/** Tunes to a single frequency and drops what it receives. */
+	class BenchmarkPhy : public ReservationPhy {
+	public:
+		void receiveFromUpper(L2Packet* data, unsigned int center_frequency) override {
+			radio->sendToChannel(data, center_frequency);
+		}
+
+		unsigned long getCurrentDatarate() const override { return 0; }
+
+		void onSharedReception(L2PacketReception, uint64_t) override {
+			num_received++;
+		}
+
+		size_t num_received = 0;
+	};
+
+	/** Argument is the fleet size; a tenth of the fleet broadcasts per slot, users are spread over 400x400 km and the range is 100 km. */
+	void ReferenceChannel_deliver(benchmark::State& state) {
+		ReferenceChannel channel(100000.0);
+		std::vector<std::unique_ptr<ReferenceRadio>> radios;
+		std::vector<std::unique_ptr<BenchmarkPhy>> phys;
+		std::mt19937 generator = std::mt19937(0);
+		std::uniform_real_distribution<double> horizontal = std::uniform_real_distribution<double>(0.0, 400000.0), vertical = std::uniform_real_distribution<double>(0.0, 12000.0);
+		for (int64_t id = 0; id < state.range(0); id++) {
+			radios.emplace_back(new ReferenceRadio(channel, MacId((int) id), SimulatorPosition(horizontal(generator), horizontal(generator), vertical(generator))));
+			phys.emplace_back(new BenchmarkPhy());
+			radios.back()->setPhy(phys.back().get());
+			phys.back()->setRadio(radios.back().get());
+		}
+		size_t num_receptions = 0;
+		while (state.keepRunning()) {
+			for (auto& phy : phys) {
+				phy->update(1);
+				phy->tuneReceiver(1000);
+			}
+			for (size_t sender = 0; sender < phys.size(); sender += 10)
+				phys[sender]->receiveFromUpper(new L2Packet(), 1000);
+			num_receptions += channel.deliver();
+		}
+		state.setItemsProcessed(num_receptions);
+	}
+}
+
+namespace {
+	/** The receiving side of the reference stack, DelayMac -> PassThroughArq -> PassThroughRlc. */
+	class ReceivingStack {
+	public:
+		ReceivingStack() : mac(MacId(1)) {
+			rlc.setLowerLayer(&arq);
+			arq.setUpperLayer(&rlc);
+			arq.setLowerLayer(&mac);
+			mac.setUpperLayer(&arq);
+		}
+
+		PassThroughRlc rlc;
+		PassThroughArq arq;
+		DelayMac mac;
+	};
+
+	/** @return A broadcast with an SH and 'num_messages' unicast messages, each with a 1000-bit payload. */
+	L2Packet* buildBroadcast(int64_t num_messages) {
+		auto* packet = new L2Packet();
+		packet->addMessage(new L2HeaderSH(MacId(2)), nullptr);
+		for (int64_t i = 0; i < num_messages; i++) {
+			auto* payload = new InetPacketPayload();
+			payload->size = 1000;
+			packet->addMessage(new L2HeaderPP(MacId(3)), payload);
+		}
+		return packet;
+	}
+
+	/** Arguments are the number of receivers and of messages in the broadcast. Every receiver's stack reads the shared packet. */
+	void Broadcast_fanout_shared(benchmark::State& state) {
+		ReceivingStack stack;
+		const int64_t num_receivers = state.range(0);
+		while (state.keepRunning()) {
+			const L2PacketReception shared = L2PacketReception(buildBroadcast(state.range(1)));
+			for (int64_t receiver = 0; receiver < num_receivers; receiver++) {
+				L2PacketReception reception = shared;
+				reception.descriptor.snr = (double) receiver;
+				stack.mac.receiveSharedFromLower(std::move(reception), 0);
+			}
+		}
+		benchmark::doNotOptimize(stack.rlc.getNumReceived());
+		state.setItemsProcessed(state.iterations() * num_receivers);
+	}
+
+	/** Same fan-out, where every receiver's stack gets its own copy, as through IPhy::onReception(). */
+	void Broadcast_fanout_copying(benchmark::State& state) {
+		ReceivingStack stack;
+		const int64_t num_receivers = state.range(0);
+		while (state.keepRunning()) {
+			const L2PacketReception shared = L2PacketReception(buildBroadcast(state.range(1)));
+			for (int64_t receiver = 0; receiver < num_receivers; receiver++) {
+				L2PacketReception reception = shared;
+				reception.descriptor.snr = (double) receiver;
+				stack.mac.receiveFromLower(reception.release(), 0);
+			}
+		}
+		benchmark::doNotOptimize(stack.rlc.getNumReceived());
+		state.setItemsProcessed(state.iterations() * num_receivers);
+	}
+}
+
+GLUE_BENCHMARK(Broadcast_fanout_shared)->args({8, 4})->args({64, 4})->args({512, 4})->args({64, 32})->argNames({"receivers", "messages"});
+GLUE_BENCHMARK(Broadcast_fanout_copying)->args({8, 4})->args({64, 4})->args({512, 4})->args({64, 32})->argNames({"receivers", "messages"});
+GLUE_BENCHMARK(ReferenceChannel_deliver)->range(64, 4096)->argNames({"fleet"});
+GLUE_BENCHMARK(SlotReservationBitmap_isIdle)->range(1, 64)->argNames({"slots"});
+GLUE_BENCHMARK(SlotReservationBitmap_isIdle_perSlotLoop)->range(1, 64)->argNames({"slots"});
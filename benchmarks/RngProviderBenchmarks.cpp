@@ -0,0 +1,76 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Benchmark.hpp"
+#include "../RngProvider.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	/** Argument is the number of registered RNG users, e.g. one per node of the fleet. */
+	void RngProvider_getInt(benchmark::State& state) {
+		RngProvider::getInstance().reset();
+		std::vector<std::unique_ptr<IRng>> users;
+		for (int64_t i = 0; i < state.range(0); i++)
+			users.emplace_back(new IRng());
+		size_t user = 0;
+		while (state.keepRunning()) {
+			benchmark::doNotOptimize(RngProvider::getInstance().getInt(users[user].get(), 0, 100));
+			user = user + 1 == users.size() ? 0 : user + 1;
+		}
+		RngProvider::getInstance().reset();
+	}
+
+	/** Draws 'candidates' slot offsets one by one, as the contention-based slot selection does. */
+	void IRng_getRandomInt_loop(benchmark::State& state) {
+		RngProvider::getInstance().reset();
+		IRng user;
+		std::vector<int> values = std::vector<int>(state.range(0));
+		while (state.keepRunning()) {
+			for (auto& value : values)
+				value = user.getRandomInt(0, 1000);
+			benchmark::doNotOptimize(values);
+		}
+		state.setItemsProcessed(state.iterations() * state.range(0));
+		RngProvider::getInstance().reset();
+	}
+
+	/** Like IRng_getRandomInt_loop, but in a single bulk call. */
+	void IRng_fillRandomInts(benchmark::State& state) {
+		RngProvider::getInstance().reset();
+		IRng user;
+		std::vector<int> values = std::vector<int>(state.range(0));
+		while (state.keepRunning()) {
+			user.fillRandomInts(0, 1000, values.data(), values.size());
+			benchmark::doNotOptimize(values);
+		}
+		state.setItemsProcessed(state.iterations() * state.range(0));
+		RngProvider::getInstance().reset();
+	}
+
+	/** Argument is the exclusive upper bound of the drawn integers. */
+	void IntegerUniformRng_get(benchmark::State& state) {
+		IntegerUniformRng rng = IntegerUniformRng(0, 0);
+		const int max = (int) state.range(0);
+		while (state.keepRunning())
+			benchmark::doNotOptimize(rng.get(0, max));
+	}
+}
+
+GLUE_BENCHMARK(RngProvider_getInt)->range(1, 512)->argNames({"fleet"});
+GLUE_BENCHMARK(IRng_getRandomInt_loop)->range(8, 1024)->argNames({"candidates"});
+GLUE_BENCHMARK(IRng_fillRandomInts)->range(8, 1024)->argNames({"candidates"});
+GLUE_BENCHMARK(IntegerUniformRng_get)->range(2, 1 << 20)->argNames({"max"});
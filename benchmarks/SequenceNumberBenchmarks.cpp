@@ -0,0 +1,69 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Benchmark.hpp"
+#include "../SequenceNumber.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	/** Argument is the number of operations per iteration. */
+	void SequenceNumber_increment(benchmark::State& state) {
+		SequenceNumber seqno = SequenceNumber(SEQNO_FIRST);
+		while (state.keepRunning()) {
+			for (int64_t i = 0; i < state.range(0); i++)
+				seqno.increment();
+			benchmark::doNotOptimize(seqno);
+		}
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void SequenceNumber_decrement(benchmark::State& state) {
+		SequenceNumber seqno = SequenceNumber(SEQNO_FIRST);
+		while (state.keepRunning()) {
+			for (int64_t i = 0; i < state.range(0); i++)
+				seqno.decrement();
+			benchmark::doNotOptimize(seqno);
+		}
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void SequenceNumber_add(benchmark::State& state) {
+		SequenceNumber seqno = SequenceNumber(SEQNO_FIRST);
+		while (state.keepRunning()) {
+			for (int64_t i = 0; i < state.range(0); i++)
+				seqno = seqno + uint8_t(1 + i % 200);
+			benchmark::doNotOptimize(seqno);
+		}
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void SequenceNumber_isHigherThan(benchmark::State& state) {
+		SequenceNumber seqno = SequenceNumber(100), other = SequenceNumber(SEQNO_FIRST);
+		while (state.keepRunning()) {
+			for (int64_t i = 0; i < state.range(0); i++) {
+				benchmark::doNotOptimize(seqno.isHigherThan(other, 127));
+				other.increment();
+			}
+		}
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+}
+
+GLUE_BENCHMARK(SequenceNumber_increment)->arg(1)->arg(256)->argNames({"ops"});
+GLUE_BENCHMARK(SequenceNumber_decrement)->arg(1)->arg(256)->argNames({"ops"});
+GLUE_BENCHMARK(SequenceNumber_add)->arg(1)->arg(256)->argNames({"ops"});
+GLUE_BENCHMARK(SequenceNumber_isHigherThan)->arg(1)->arg(256)->argNames({"ops"});
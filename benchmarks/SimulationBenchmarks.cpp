@@ -0,0 +1,39 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Benchmark.hpp"
+#include "../simulation/HeadlessSimulation.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	/** Arguments are the number of nodes and of threads. Compare the real time across thread counts for the parallel speedup of a slot. */
+	void HeadlessSimulation_slot(benchmark::State& state) {
+		HeadlessSimulation::Config config;
+		config.num_nodes = (size_t) state.range(0);
+		config.area_side = 200000.0;
+		config.traffic = "bernoulli:0.05";
+		config.num_threads = (size_t) state.range(1);
+		HeadlessSimulation simulation(config);
+		size_t num_received = 0;
+		while (state.keepRunning())
+			num_received += simulation.run(1).num_received;
+		benchmark::doNotOptimize(num_received);
+		state.setItemsProcessed(state.iterations() * state.range(0));
+	}
+}
+
+GLUE_BENCHMARK(HeadlessSimulation_slot)->args({1000, 1})->args({1000, 2})->args({1000, 4})->args({1000, 8})->argNames({"nodes", "threads"});
@@ -0,0 +1,27 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Benchmark.hpp"
+#include "L2PacketBenchmarks.cpp"
+#include "SequenceNumberBenchmarks.cpp"
+#include "RngProviderBenchmarks.cpp"
+#include "MacBenchmarks.cpp"
+#include "PhyBenchmarks.cpp"
+#include "SimulationBenchmarks.cpp"
+
+int main(int argc, char** argv) {
+	return TUHH_INTAIRNET_MCSOTDMA::benchmark::runSpecifiedBenchmarks(argc, argv);
+}
@@ -0,0 +1,105 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "HeadlessSimulation.hpp"
+#include <chrono>
+#include <stdexcept>
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+namespace {
+	/** Draws node positions, from its own stream of the simulation's provider. */
+	class RandomPlacement : public IRng {
+	public:
+		/** Draws come from [0, resolution) per axis. */
+		static constexpr int resolution = 1 << 30;
+
+		SimulatorPosition draw(double side) {
+			int values[2];
+			fillRandomInts(0, resolution, values, 2);
+			return SimulatorPosition(side * values[0] / resolution, side * values[1] / resolution, 0.0);
+		}
+	};
+}
+
+double HeadlessSimulation::Result::getSlotsPerSecond() const {
+	return wall_seconds > 0.0 ? num_slots / wall_seconds : 0.0;
+}
+
+double HeadlessSimulation::Result::getPacketsPerSecond() const {
+	return wall_seconds > 0.0 ? (num_transmitted + num_received) / wall_seconds : 0.0;
+}
+
+HeadlessSimulation::HeadlessSimulation(const Config& config) : channel(config.range), executor(config.num_threads) {
+	if (config.num_nodes == 0)
+		throw std::invalid_argument("HeadlessSimulation for zero nodes.");
+	if (!(config.area_side > 0.0))
+		throw std::invalid_argument("HeadlessSimulation for non-positive area side length " + std::to_string(config.area_side) + ".");
+	provider.setSeed(config.seed);
+	RngProvider::Binding binding(provider);
+	RandomPlacement placement;
+	nodes.reserve(config.num_nodes);
+	for (size_t i = 0; i < config.num_nodes; i++)
+		nodes.emplace_back(new SimulationNode(channel, MacId((int) i + 1), placement.draw(config.area_side), TrafficGenerator::parse(config.traffic, i)));
+	transmit_phase = [this](size_t i) {
+		nodes[i]->startSlot(current_slot);
+	};
+	exchange = [this]() {
+		channel.distribute();
+	};
+	receive_phase = [this](size_t i) {
+		nodes[i]->receive();
+		nodes[i]->endSlot();
+	};
+}
+
+HeadlessSimulation::Result HeadlessSimulation::run(uint64_t num_slots) {
+	const Result before = count();
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < num_slots; i++)
+		step();
+	const auto end = std::chrono::steady_clock::now();
+	Result result = count();
+	result.num_slots = num_slots;
+	result.num_generated -= before.num_generated;
+	result.num_transmitted -= before.num_transmitted;
+	result.num_received -= before.num_received;
+	result.wall_seconds = std::chrono::duration<double>(end - start).count();
+	return result;
+}
+
+void HeadlessSimulation::step() {
+	current_slot++;
+	executor.runSlot(nodes.size(), transmit_phase, exchange, receive_phase);
+}
+
+HeadlessSimulation::Result HeadlessSimulation::count() const {
+	Result result;
+	for (const auto& node : nodes) {
+		result.num_generated += node->getNumGenerated();
+		result.num_transmitted += node->getNumTransmitted();
+		result.num_received += node->getNumReceived();
+	}
+	return result;
+}
+
+uint64_t HeadlessSimulation::getCurrentSlot() const {
+	return current_slot;
+}
+
+const std::vector<std::unique_ptr<SimulationNode>>& HeadlessSimulation::getNodes() const {
+	return nodes;
+}
@@ -0,0 +1,102 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_HEADLESSSIMULATION_HPP
+#define INTAIRNET_LINKLAYER_GLUE_HEADLESSSIMULATION_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../RngProvider.hpp"
+#include "../ReferenceChannel.hpp"
+#include "../SlotExecutor.hpp"
+#include "SimulationNode.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Runs the glue stack of many nodes on a ReferenceChannel, without OMNeT++.
+	 * Nodes are placed uniformly at random on a square; each slot, every node starts the slot, then the channel distributes, then every node receives and ends the slot.
+	 * Both phases run on a SlotExecutor, so that nodes are processed in parallel if more than one thread is configured.
+	 */
+	class HeadlessSimulation {
+	public:
+		struct Config {
+			size_t num_nodes = 100;
+			/** Side length of the square the nodes are placed on, in meters. */
+			double area_side = 100000.0;
+			/** Communication range, in meters. */
+			double range = 50000.0;
+			/** See TrafficGenerator::parse(). */
+			std::string traffic = "periodic:10";
+			uint64_t seed = 0;
+			/** Threads that process the nodes; results don't depend on it. */
+			size_t num_threads = 1;
+		};
+
+		struct Result {
+			uint64_t num_slots = 0;
+			size_t num_generated = 0;
+			size_t num_transmitted = 0;
+			size_t num_received = 0;
+			double wall_seconds = 0.0;
+
+			double getSlotsPerSecond() const;
+
+			/** @return Transmitted and received packets per second. */
+			double getPacketsPerSecond() const;
+		};
+
+		/**
+		 * Creates all nodes. Their random streams come from a provider of this simulation, so that several simulations may run in parallel.
+		 * @param config
+		 * @throws std::invalid_argument For invalid configurations.
+		 */
+		explicit HeadlessSimulation(const Config& config);
+
+		HeadlessSimulation(const HeadlessSimulation& other) = delete;
+		HeadlessSimulation& operator=(const HeadlessSimulation& other) = delete;
+
+		/**
+		 * Runs the next time slots and measures their wall-clock time.
+		 * @param num_slots
+		 * @return Counts for these slots only.
+		 */
+		Result run(uint64_t num_slots);
+
+		/** @return Number of slots run so far. */
+		uint64_t getCurrentSlot() const;
+
+		const std::vector<std::unique_ptr<SimulationNode>>& getNodes() const;
+
+	protected:
+		/** Runs a single time slot. */
+		void step();
+
+		/** Sums up the counters of all nodes. */
+		Result count() const;
+
+		RngProvider provider;
+		ReferenceChannel channel;
+		std::vector<std::unique_ptr<SimulationNode>> nodes;
+		SlotExecutor executor;
+		std::function<void(size_t)> transmit_phase, receive_phase;
+		std::function<void()> exchange;
+		uint64_t current_slot = 0;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_HEADLESSSIMULATION_HPP
@@ -0,0 +1,136 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SimulationNode.hpp"
+#include "../L3Packet.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+unsigned int SimulationNet::getNumHopsToGroundStation() const {
+	return 0;
+}
+
+void SimulationNet::reportNumHopsToGS(const MacId&, unsigned int) {}
+
+void SimulationNet::receiveFromLower(L3Packet* packet) {
+	delete packet;
+}
+
+void SimulationNet::generatePacket() {
+	auto* packet = new L3Packet();
+	packet->dest = SYMBOLIC_LINK_ID_BROADCAST;
+	packet->original = nullptr;
+	lower_layer->receiveFromUpper(packet, packet->dest);
+}
+
+SimulationPhy::SimulationPhy(unsigned long datarate) : ReservationPhy(), datarate(datarate) {}
+
+void SimulationPhy::receiveFromUpper(L2Packet* data, unsigned int center_frequency) {
+	num_transmitted++;
+	transmitter_reservations.reserve(0);
+	radio->sendToChannel(data, center_frequency);
+}
+
+unsigned long SimulationPhy::getCurrentDatarate() const {
+	return datarate;
+}
+
+void SimulationPhy::onReception(L2Packet* packet, uint64_t center_frequency) {
+	num_received++;
+	IPhy::onReception(packet, center_frequency);
+}
+
+void SimulationPhy::onSharedReception(L2PacketReception reception, uint64_t center_frequency) {
+	num_received++;
+	upper_layer->receiveSharedFromLower(std::move(reception), center_frequency);
+}
+
+size_t SimulationPhy::getNumTransmitted() const {
+	return num_transmitted;
+}
+
+size_t SimulationPhy::getNumReceived() const {
+	return num_received;
+}
+
+constexpr uint64_t SimulationNode::center_frequency;
+
+SimulationNode::SimulationNode(ReferenceChannel& channel, const MacId& id, const SimulatorPosition& position, std::unique_ptr<TrafficGenerator> traffic)
+	: id(id), traffic(std::move(traffic)), mac(id), radio(channel, id, position) {
+	net.setLowerLayer(&rlc);
+	rlc.setUpperLayer(&net);
+	rlc.setLowerLayer(&arq);
+	// The RLC sublayer hands network-layer packets back once it has sent them.
+	rlc.registerDeleteL3Callback([](L3Packet* packet) {delete packet;});
+	arq.setUpperLayer(&rlc);
+	arq.setLowerLayer(&mac);
+	mac.setUpperLayer(&arq);
+	mac.setLowerLayer(&phy);
+	phy.setUpperLayer(&mac);
+	phy.setRadio(&radio);
+	radio.setPhy(&phy);
+}
+
+void SimulationNode::startSlot(uint64_t slot) {
+	mac.update(1);
+	phy.update(1);
+	phy.tuneReceiver(center_frequency);
+	for (unsigned int i = traffic->getNumPackets(slot); i > 0; i--) {
+		net.generatePacket();
+		num_generated++;
+	}
+	mac.execute();
+}
+
+void SimulationNode::receive() {
+	radio.deliverPending();
+}
+
+void SimulationNode::endSlot() {
+	mac.onSlotEnd();
+}
+
+const MacId& SimulationNode::getId() const {
+	return id;
+}
+
+size_t SimulationNode::getNumGenerated() const {
+	return num_generated;
+}
+
+size_t SimulationNode::getNumTransmitted() const {
+	return phy.getNumTransmitted();
+}
+
+size_t SimulationNode::getNumReceived() const {
+	return phy.getNumReceived();
+}
+
+PassThroughRlc& SimulationNode::getRlc() {
+	return rlc;
+}
+
+DelayMac& SimulationNode::getMac() {
+	return mac;
+}
+
+SimulationPhy& SimulationNode::getPhy() {
+	return phy;
+}
+
+ReferenceRadio& SimulationNode::getRadio() {
+	return radio;
+}
@@ -0,0 +1,131 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_SIMULATIONNODE_HPP
+#define INTAIRNET_LINKLAYER_GLUE_SIMULATIONNODE_HPP
+
+#include <memory>
+#include "../MacId.hpp"
+#include "../INet.hpp"
+#include "../ReservationPhy.hpp"
+#include "../PassThroughRlc.hpp"
+#include "../PassThroughArq.hpp"
+#include "../DelayMac.hpp"
+#include "../ReferenceChannel.hpp"
+#include "TrafficGenerator.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/** Network layer of a simulated node: generates traffic and discards whatever is passed up. */
+	class SimulationNet : public INet {
+	public:
+		unsigned int getNumHopsToGroundStation() const override;
+
+		void reportNumHopsToGS(const MacId& id, unsigned int num_hops) override;
+
+		void receiveFromLower(L3Packet* packet) override;
+
+		/** Passes a new broadcast packet to the RLC sublayer. */
+		void generatePacket();
+	};
+
+	/** PHY layer of a simulated node: sends through its radio and counts packets. */
+	class SimulationPhy : public ReservationPhy {
+	public:
+		/** @param datarate In bits per slot. */
+		explicit SimulationPhy(unsigned long datarate = 1000);
+
+		void receiveFromUpper(L2Packet* data, unsigned int center_frequency) override;
+
+		unsigned long getCurrentDatarate() const override;
+
+		void onReception(L2Packet* packet, uint64_t center_frequency) override;
+
+		/** Hands the reception up without copying the shared packet. */
+		void onSharedReception(L2PacketReception reception, uint64_t center_frequency) override;
+
+		size_t getNumTransmitted() const;
+
+		size_t getNumReceived() const;
+
+	protected:
+		const unsigned long datarate;
+		size_t num_transmitted = 0;
+		size_t num_received = 0;
+	};
+
+	/**
+	 * A complete glue stack SimulationNet -> PassThroughRlc -> PassThroughArq -> DelayMac -> SimulationPhy -> ReferenceRadio.
+	 * All state belongs to the node, s.t. different nodes never touch each other except through the channel.
+	 */
+	class SimulationNode {
+	public:
+		/**
+		 * @param channel Must outlive this node.
+		 * @param id
+		 * @param position In meters.
+		 * @param traffic Decides when to generate packets.
+		 */
+		SimulationNode(ReferenceChannel& channel, const MacId& id, const SimulatorPosition& position, std::unique_ptr<TrafficGenerator> traffic);
+
+		SimulationNode(const SimulationNode& other) = delete;
+		SimulationNode& operator=(const SimulationNode& other) = delete;
+
+		/**
+		 * Starts a new time slot: advances MAC and PHY, tunes the receiver, generates traffic and lets the MAC transmit.
+		 * Transmissions are queued at the channel until it delivers them.
+		 * @param slot The new slot.
+		 */
+		void startSlot(uint64_t slot);
+
+		/** Passes this node's receptions, which the channel has distributed, up the stack. */
+		void receive();
+
+		/** Ends the current time slot. */
+		void endSlot();
+
+		const MacId& getId() const;
+
+		size_t getNumGenerated() const;
+
+		size_t getNumTransmitted() const;
+
+		size_t getNumReceived() const;
+
+		PassThroughRlc& getRlc();
+
+		DelayMac& getMac();
+
+		SimulationPhy& getPhy();
+
+		ReferenceRadio& getRadio();
+
+	protected:
+		/** DelayMac sends everything on this frequency. */
+		static constexpr uint64_t center_frequency = 0;
+		const MacId id;
+		std::unique_ptr<TrafficGenerator> traffic;
+		SimulationNet net;
+		PassThroughRlc rlc;
+		PassThroughArq arq;
+		DelayMac mac;
+		SimulationPhy phy;
+		ReferenceRadio radio;
+		size_t num_generated = 0;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_SIMULATIONNODE_HPP
@@ -0,0 +1,67 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "TrafficGenerator.hpp"
+#include <cmath>
+#include <stdexcept>
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+std::unique_ptr<TrafficGenerator> TrafficGenerator::parse(const std::string& specification, uint64_t offset) {
+	if (specification == "none")
+		return std::unique_ptr<TrafficGenerator>(new NoTraffic());
+	const size_t separator = specification.find(':');
+	if (separator == std::string::npos)
+		throw std::invalid_argument("TrafficGenerator::parse for unknown traffic '" + specification + "'.");
+	const std::string kind = specification.substr(0, separator), value = specification.substr(separator + 1);
+	try {
+		if (kind == "periodic") {
+			const uint64_t interval = std::stoull(value);
+			return std::unique_ptr<TrafficGenerator>(new PeriodicTraffic(interval, interval == 0 ? 0 : offset % interval));
+		}
+		if (kind == "bernoulli")
+			return std::unique_ptr<TrafficGenerator>(new BernoulliTraffic(std::stod(value)));
+	} catch (const std::logic_error& e) {
+		// std::invalid_argument and std::out_of_range from parsing the value, or from the constructors.
+		throw std::invalid_argument("TrafficGenerator::parse for invalid traffic '" + specification + "': " + e.what());
+	}
+	throw std::invalid_argument("TrafficGenerator::parse for unknown traffic '" + specification + "'.");
+}
+
+unsigned int NoTraffic::getNumPackets(uint64_t) {
+	return 0;
+}
+
+PeriodicTraffic::PeriodicTraffic(uint64_t interval, uint64_t offset) : interval(interval), offset(offset) {
+	if (interval == 0)
+		throw std::invalid_argument("PeriodicTraffic for zero interval.");
+}
+
+unsigned int PeriodicTraffic::getNumPackets(uint64_t slot) {
+	return slot >= offset && (slot - offset) % interval == 0 ? 1 : 0;
+}
+
+static int toThreshold(double probability, int resolution) {
+	if (!(probability >= 0.0 && probability <= 1.0))
+		throw std::invalid_argument("BernoulliTraffic for probability " + std::to_string(probability) + " outside of [0, 1].");
+	return (int) std::lround(probability * resolution);
+}
+
+BernoulliTraffic::BernoulliTraffic(double probability) : IRng(), threshold(toThreshold(probability, resolution)) {}
+
+unsigned int BernoulliTraffic::getNumPackets(uint64_t) {
+	return getRandomInt(0, resolution) < threshold ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INTAIRNET_LINKLAYER_GLUE_TRAFFICGENERATOR_HPP
+#define INTAIRNET_LINKLAYER_GLUE_TRAFFICGENERATOR_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "../RngProvider.hpp"
+
+namespace TUHH_INTAIRNET_MCSOTDMA {
+
+	/**
+	 * Decides how many network-layer packets a node generates per time slot.
+	 * Each node owns its own generator, and random generators draw from their own stream, so nodes can generate traffic independently.
+	 */
+	class TrafficGenerator {
+	public:
+		virtual ~TrafficGenerator() = default;
+
+		/**
+		 * @param slot Current time slot.
+		 * @return Number of packets to generate during this slot.
+		 */
+		virtual unsigned int getNumPackets(uint64_t slot) = 0;
+
+		/**
+		 * Parses a traffic specification, which is one of
+		 * "none",
+		 * "periodic:<interval>" for one packet every <interval> slots,
+		 * "bernoulli:<probability>" for one packet per slot with the given probability.
+		 * @param specification
+		 * @param offset Of periodic traffic, s.t. nodes don't all generate packets during the same slot.
+		 * @return A new generator.
+		 * @throws std::invalid_argument For malformed specifications.
+		 */
+		static std::unique_ptr<TrafficGenerator> parse(const std::string& specification, uint64_t offset = 0);
+	};
+
+	/** Generates no traffic. */
+	class NoTraffic : public TrafficGenerator {
+	public:
+		unsigned int getNumPackets(uint64_t slot) override;
+	};
+
+	/** Generates a single packet every 'interval' slots. */
+	class PeriodicTraffic : public TrafficGenerator {
+	public:
+		/**
+		 * @param interval In slots.
+		 * @param offset Slot of the first packet.
+		 * @throws std::invalid_argument If 'interval' is zero.
+		 */
+		explicit PeriodicTraffic(uint64_t interval, uint64_t offset = 0);
+
+		unsigned int getNumPackets(uint64_t slot) override;
+
+	protected:
+		const uint64_t interval;
+		const uint64_t offset;
+	};
+
+	/** Generates a single packet per slot with fixed probability. Signs up with the RngProvider of the constructing thread. */
+	class BernoulliTraffic : public TrafficGenerator, public IRng {
+	public:
+		/**
+		 * @param probability
+		 * @throws std::invalid_argument If 'probability' is outside of [0, 1].
+		 */
+		explicit BernoulliTraffic(double probability);
+
+		unsigned int getNumPackets(uint64_t slot) override;
+
+	protected:
+		/** Draws come from [0, resolution). */
+		static constexpr int resolution = 1000000;
+		const int threshold;
+	};
+}
+
+#endif //INTAIRNET_LINKLAYER_GLUE_TRAFFICGENERATOR_HPP
@@ -0,0 +1,84 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "HeadlessSimulation.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+/**
+ * Headless simulation driver, e.g. to size hardware for large fleets or to profile the glue library without OMNeT++.
+ * Usage: glue-sim [--nodes N] [--slots N] [--warmup N] [--area METERS] [--range METERS] [--traffic none|periodic:INTERVAL|bernoulli:PROBABILITY] [--seed N] [--threads N]
+ * With --threads 0, all cores are used.
+ */
+int main(int argc, char** argv) {
+	HeadlessSimulation::Config config;
+	uint64_t num_slots = 10000, num_warmup_slots = 100;
+	try {
+		for (int i = 1; i < argc; i += 2) {
+			const std::string option = argv[i];
+			if (option == "--help") {
+				std::cout << "Usage: " << argv[0] << " [--nodes N] [--slots N] [--warmup N] [--area METERS] [--range METERS] [--traffic none|periodic:INTERVAL|bernoulli:PROBABILITY] [--seed N] [--threads N]" << std::endl;
+				return EXIT_SUCCESS;
+			}
+			if (i + 1 >= argc)
+				throw std::invalid_argument("missing value for " + option);
+			const std::string value = argv[i + 1];
+			if (option == "--nodes")
+				config.num_nodes = std::stoull(value);
+			else if (option == "--slots")
+				num_slots = std::stoull(value);
+			else if (option == "--warmup")
+				num_warmup_slots = std::stoull(value);
+			else if (option == "--area")
+				config.area_side = std::stod(value);
+			else if (option == "--range")
+				config.range = std::stod(value);
+			else if (option == "--traffic")
+				config.traffic = value;
+			else if (option == "--seed")
+				config.seed = std::stoull(value);
+			else if (option == "--threads")
+				config.num_threads = std::stoull(value);
+			else
+				throw std::invalid_argument("unknown option " + option);
+		}
+
+		if (config.num_threads == 0)
+			config.num_threads = std::max(1u, std::thread::hardware_concurrency());
+		HeadlessSimulation simulation(config);
+		simulation.run(num_warmup_slots);
+		const HeadlessSimulation::Result result = simulation.run(num_slots);
+		std::cout << "nodes:            " << config.num_nodes << std::endl
+		          << "threads:          " << config.num_threads << std::endl
+		          << "slots:            " << result.num_slots << std::endl
+		          << "wall time [s]:    " << result.wall_seconds << std::endl
+		          << "generated:        " << result.num_generated << std::endl
+		          << "transmitted:      " << result.num_transmitted << std::endl
+		          << "received:         " << result.num_received << std::endl
+		          << "slots/s:          " << result.getSlotsPerSecond() << std::endl
+		          << "packets/s:        " << result.getPacketsPerSecond() << std::endl;
+	} catch (const std::exception& e) {
+		std::cerr << argv[0] << ": " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
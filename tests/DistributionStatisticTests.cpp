@@ -0,0 +1,151 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include "../HistogramStatistic.hpp"
+#include "../QuantileStatistic.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class DistributionStatisticTests : public CppUnit::TestFixture {
+private:
+	IOmnetPluggable* pluggable;
+	std::map<std::string, double> emitted;
+	size_t num_emitted = 0;
+	std::vector<double> samples;
+
+	double exactQuantile(double quantile) const {
+		std::vector<double> sorted = samples;
+		std::sort(sorted.begin(), sorted.end());
+		const size_t rank = std::max(size_t(1), (size_t) std::ceil(quantile * sorted.size()));
+		return sorted.at(rank - 1);
+	}
+
+public:
+	void setUp() override {
+		pluggable = new IOmnetPluggable();
+		emitted.clear();
+		num_emitted = 0;
+		pluggable->registerEmitEventCallback([this](std::string name, double value) {
+			emitted[name] = value;
+			num_emitted++;
+		});
+		// Exponentially distributed latencies with a mean of 200 slots.
+		std::mt19937 generator = std::mt19937(42);
+		std::exponential_distribution<double> distribution = std::exponential_distribution<double>(1.0 / 200.0);
+		samples.clear();
+		for (size_t i = 0; i < 20000; i++)
+			samples.push_back(std::floor(distribution(generator)));
+	}
+
+	void tearDown() override {
+		delete pluggable;
+	}
+
+	void testHistogramQuantiles() {
+		HistogramStatistic histogram = HistogramStatistic("link_establishment_time", pluggable, 100000.0, 3);
+		for (double sample : samples)
+			histogram.capture(sample);
+		CPPUNIT_ASSERT_EQUAL(uint64_t(samples.size()), histogram.getCount());
+		CPPUNIT_ASSERT_EQUAL(*std::min_element(samples.begin(), samples.end()), histogram.getMin());
+		CPPUNIT_ASSERT_EQUAL(*std::max_element(samples.begin(), samples.end()), histogram.getMax());
+		for (double quantile : {0.01, 0.1, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+			const double exact = exactQuantile(quantile);
+			// Three significant digits.
+			CPPUNIT_ASSERT(std::abs(histogram.getQuantile(quantile) - exact) <= std::max(1.0, exact * 0.001));
+		}
+		CPPUNIT_ASSERT_EQUAL(uint64_t(0), histogram.getNumSaturated());
+		histogram.capture(1e6);
+		CPPUNIT_ASSERT_EQUAL(uint64_t(1), histogram.getNumSaturated());
+		CPPUNIT_ASSERT_THROW(histogram.capture(-1.0), std::invalid_argument);
+		CPPUNIT_ASSERT_THROW(HistogramStatistic("h", pluggable, 1000.0, 6), std::invalid_argument);
+	}
+
+	void testRejectedSampleLeavesSummary() {
+		HistogramStatistic histogram = HistogramStatistic("h", pluggable, 1000.0);
+		histogram.capture(4.0);
+		histogram.capture(8.0);
+		CPPUNIT_ASSERT_THROW(histogram.capture(-1.0), std::invalid_argument);
+		CPPUNIT_ASSERT_THROW(histogram.capture(std::nan("")), std::invalid_argument);
+		CPPUNIT_ASSERT_EQUAL(uint64_t(2), histogram.getCount());
+		CPPUNIT_ASSERT_EQUAL(6.0, histogram.getMean());
+		CPPUNIT_ASSERT_EQUAL(4.0, histogram.getMin());
+		CPPUNIT_ASSERT_EQUAL(8.0, histogram.getMax());
+		CPPUNIT_ASSERT_EQUAL(8.0, histogram.getQuantile(1.0));
+	}
+
+	void testHistogramSmallValues() {
+		// Below the first bucket boundary, every value has its own bucket.
+		HistogramStatistic histogram = HistogramStatistic("h", pluggable, 1000.0, 2, 0.5);
+		for (double sample : {0.0, 0.5, 1.0, 1.5, 2.0})
+			histogram.capture(sample);
+		CPPUNIT_ASSERT_EQUAL(0.0, histogram.getQuantile(0.2));
+		CPPUNIT_ASSERT_EQUAL(1.0, histogram.getQuantile(0.5));
+		CPPUNIT_ASSERT_EQUAL(2.0, histogram.getQuantile(1.0));
+	}
+
+	void testQuantileEstimates() {
+		QuantileStatistic statistic = QuantileStatistic("link_establishment_time", pluggable, {0.5, 0.9, 0.99});
+		CPPUNIT_ASSERT_EQUAL(0.0, statistic.getQuantile(0.5));
+		for (size_t i = 0; i < 3; i++)
+			statistic.capture(samples.at(i));
+		// Exact while there are fewer samples than markers.
+		CPPUNIT_ASSERT_EQUAL(std::max(samples.at(0), std::max(samples.at(1), samples.at(2))), statistic.getQuantile(0.99));
+		for (size_t i = 3; i < samples.size(); i++)
+			statistic.capture(samples.at(i));
+		for (double quantile : {0.5, 0.9, 0.99}) {
+			const double exact = exactQuantile(quantile);
+			CPPUNIT_ASSERT(std::abs(statistic.getQuantile(quantile) - exact) <= 0.05 * exact);
+		}
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(200.0, statistic.getMean(), 10.0);
+		CPPUNIT_ASSERT_THROW(statistic.getQuantile(0.75), std::invalid_argument);
+	}
+
+	void testEmission() {
+		QuantileStatistic statistic = QuantileStatistic("latency", pluggable, {0.5, 0.999}, 10);
+		// Nothing to emit before the first sample.
+		statistic.update();
+		CPPUNIT_ASSERT_EQUAL(size_t(0), num_emitted);
+		for (size_t slot = 0; slot < 100; slot++) {
+			statistic.capture(samples.at(slot));
+			statistic.update();
+		}
+		// Every 10th of the 101 update() calls emits 6 values, the last one after 99 samples.
+		CPPUNIT_ASSERT_EQUAL(size_t(10 * 6), num_emitted);
+		CPPUNIT_ASSERT_EQUAL(size_t(6), emitted.size());
+		CPPUNIT_ASSERT_EQUAL(99.0, emitted.at("latency_count"));
+		CPPUNIT_ASSERT(emitted.find("latency_mean") != emitted.end());
+		CPPUNIT_ASSERT(emitted.find("latency_min") != emitted.end());
+		CPPUNIT_ASSERT(emitted.find("latency_max") != emitted.end());
+		CPPUNIT_ASSERT(emitted.find("latency_p50") != emitted.end());
+		CPPUNIT_ASSERT(emitted.find("latency_p99.9") != emitted.end());
+		CPPUNIT_ASSERT_THROW(QuantileStatistic("q", pluggable, {1.5}), std::invalid_argument);
+		CPPUNIT_ASSERT_THROW(QuantileStatistic("q", pluggable, {0.5}, 0), std::invalid_argument);
+	}
+
+	CPPUNIT_TEST_SUITE(DistributionStatisticTests);
+		CPPUNIT_TEST(testHistogramQuantiles);
+		CPPUNIT_TEST(testHistogramSmallValues);
+		CPPUNIT_TEST(testRejectedSampleLeavesSummary);
+		CPPUNIT_TEST(testQuantileEstimates);
+		CPPUNIT_TEST(testEmission);
+	CPPUNIT_TEST_SUITE_END();
+};
@@ -0,0 +1,279 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "../simulation/HeadlessSimulation.hpp"
+#include "../L3Packet.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class HeadlessSimulationTests : public CppUnit::TestFixture {
+private:
+	/** Lets the RLC sublayer send without a MAC. */
+	class TestArq : public PassThroughArq {
+	public:
+		void notifyOutgoing(unsigned int num_bits, const MacId&) override {
+			num_bits_announced += num_bits;
+		}
+
+		unsigned int num_bits_announced = 0;
+	};
+
+	/** Counts deep copies. */
+	class CountingPayload : public L2Packet::Payload {
+	public:
+		explicit CountingPayload(size_t& num_copies) : num_copies(num_copies) {}
+
+		unsigned int getBits() const override {
+			return 64;
+		}
+
+		Payload* copy() const override {
+			num_copies++;
+			return new CountingPayload(num_copies);
+		}
+
+		size_t& num_copies;
+	};
+
+	/** Keeps the default shared reception path of IMac. */
+	class CopyingMac : public DelayMac {
+	public:
+		CopyingMac() : DelayMac(MacId(1)) {}
+
+		void receiveFromLower(L2Packet* packet, uint64_t) override {
+			received.emplace_back(packet);
+		}
+
+		void receiveSharedFromLower(L2PacketReception reception, uint64_t center_frequency) override {
+			IMac::receiveSharedFromLower(std::move(reception), center_frequency);
+		}
+
+		std::vector<std::unique_ptr<L2Packet>> received;
+	};
+
+	HeadlessSimulation::Config getConfig() {
+		HeadlessSimulation::Config config;
+		config.num_nodes = 3;
+		config.area_side = 1000.0;
+		config.range = 50000.0;
+		return config;
+	}
+
+public:
+	void testTrafficGenerators() {
+		PeriodicTraffic periodic = PeriodicTraffic(10, 3);
+		CPPUNIT_ASSERT_EQUAL(0u, periodic.getNumPackets(0));
+		CPPUNIT_ASSERT_EQUAL(1u, periodic.getNumPackets(3));
+		CPPUNIT_ASSERT_EQUAL(0u, periodic.getNumPackets(4));
+		CPPUNIT_ASSERT_EQUAL(1u, periodic.getNumPackets(13));
+		CPPUNIT_ASSERT_THROW(PeriodicTraffic(0), std::invalid_argument);
+
+		std::unique_ptr<TrafficGenerator> never = TrafficGenerator::parse("bernoulli:0"), always = TrafficGenerator::parse("bernoulli:1");
+		std::unique_ptr<TrafficGenerator> none = TrafficGenerator::parse("none"), offset = TrafficGenerator::parse("periodic:5", 7);
+		for (uint64_t slot = 0; slot < 100; slot++) {
+			CPPUNIT_ASSERT_EQUAL(0u, never->getNumPackets(slot));
+			CPPUNIT_ASSERT_EQUAL(1u, always->getNumPackets(slot));
+			CPPUNIT_ASSERT_EQUAL(0u, none->getNumPackets(slot));
+			CPPUNIT_ASSERT_EQUAL(slot % 5 == 2 ? 1u : 0u, offset->getNumPackets(slot));
+		}
+		CPPUNIT_ASSERT_THROW(TrafficGenerator::parse("poisson:3"), std::invalid_argument);
+		CPPUNIT_ASSERT_THROW(TrafficGenerator::parse("periodic"), std::invalid_argument);
+		CPPUNIT_ASSERT_THROW(TrafficGenerator::parse("periodic:x"), std::invalid_argument);
+		CPPUNIT_ASSERT_THROW(TrafficGenerator::parse("periodic:0"), std::invalid_argument);
+		CPPUNIT_ASSERT_THROW(TrafficGenerator::parse("bernoulli:1.5"), std::invalid_argument);
+	}
+
+	void testPassThroughRlcReleasesPackets() {
+		size_t num_deleted = 0;
+		{
+			PassThroughRlc rlc;
+			TestArq arq;
+			rlc.setLowerLayer(&arq);
+			rlc.registerDeleteL3Callback([&num_deleted](L3Packet* packet) {
+				num_deleted++;
+				delete packet;
+			});
+			CPPUNIT_ASSERT(!rlc.isThereMoreData(SYMBOLIC_LINK_ID_BROADCAST));
+			for (int i = 0; i < 3; i++)
+				rlc.receiveFromUpper(new L3Packet(), SYMBOLIC_LINK_ID_BROADCAST);
+			CPPUNIT_ASSERT(rlc.isThereMoreData(SYMBOLIC_LINK_ID_BROADCAST));
+			CPPUNIT_ASSERT_EQUAL(arq.num_bits_announced, rlc.getQueuedDataSize(SYMBOLIC_LINK_ID_BROADCAST));
+			delete rlc.requestSegment(100, SYMBOLIC_LINK_ID_BROADCAST);
+			CPPUNIT_ASSERT_EQUAL(size_t(1), num_deleted);
+			CPPUNIT_ASSERT_EQUAL(arq.num_bits_announced * 2 / 3, rlc.getQueuedDataSize(SYMBOLIC_LINK_ID_BROADCAST));
+			rlc.receiveFromLower(new L2Packet());
+			CPPUNIT_ASSERT_EQUAL(size_t(1), rlc.getNumReceived());
+		}
+		// The remaining packets are handed back on destruction.
+		CPPUNIT_ASSERT_EQUAL(size_t(3), num_deleted);
+	}
+
+	void testDelayMac() {
+		DelayMac mac(MacId(1));
+		CPPUNIT_ASSERT(!mac.isGoingToTransmitDuringCurrentSlot(0));
+		mac.notifyOutgoing(100, SYMBOLIC_LINK_ID_BROADCAST);
+		for (int i = 0; i < 9; i++)
+			mac.execute();
+		CPPUNIT_ASSERT(mac.isGoingToTransmitDuringCurrentSlot(0));
+		mac.setSilent(true);
+		CPPUNIT_ASSERT(!mac.isGoingToTransmitDuringCurrentSlot(0));
+		mac.update(3);
+		CPPUNIT_ASSERT_EQUAL(uint64_t(3), mac.getCurrentSlot());
+	}
+
+	void testSharedReception() {
+		size_t num_copies = 0;
+		ReferenceChannel channel(50000.0);
+		std::vector<std::unique_ptr<SimulationNode>> nodes;
+		for (int id = 1; id <= 4; id++)
+			nodes.emplace_back(new SimulationNode(channel, MacId(id), SimulatorPosition(1000.0 * id, 0.0, 0.0), TrafficGenerator::parse("none")));
+		for (auto& node : nodes)
+			node->startSlot(1);
+		auto* packet = new L2Packet();
+		packet->addMessage(new L2HeaderSH(MacId(1)), new CountingPayload(num_copies));
+		nodes.at(0)->getPhy().receiveFromUpper(packet, 0);
+		CPPUNIT_ASSERT_EQUAL(size_t(3), channel.distribute());
+		for (auto& node : nodes)
+			node->receive();
+		// All three receivers' stacks read the broadcast without copying it.
+		for (size_t i = 1; i < nodes.size(); i++)
+			CPPUNIT_ASSERT_EQUAL(size_t(1), nodes.at(i)->getRlc().getNumReceived());
+		CPPUNIT_ASSERT_EQUAL(size_t(0), num_copies);
+
+		// MACs that don't override the shared path receive their own copy, which carries the per-receiver fields.
+		CopyingMac mac;
+		L2PacketReception reception = L2PacketReception(new L2Packet());
+		reception.getMutablePacket().addMessage(new L2HeaderSH(MacId(2)), new CountingPayload(num_copies));
+		reception.descriptor.snr = 12.0;
+		mac.receiveSharedFromLower(reception, 0);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), num_copies);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), mac.received.size());
+		CPPUNIT_ASSERT(mac.received.at(0).get() != &reception.getPacket());
+		CPPUNIT_ASSERT_EQUAL(12.0, mac.received.at(0)->snr);
+		CPPUNIT_ASSERT_EQUAL(0.0, reception.getPacket().snr);
+		// The last holder hands over the original instead of copying it.
+		auto* original = new L2Packet();
+		original->addMessage(new L2HeaderSH(MacId(2)), new CountingPayload(num_copies));
+		L2PacketReception last = L2PacketReception(original);
+		last.descriptor.snr = 3.0;
+		mac.receiveSharedFromLower(std::move(last), 0);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), num_copies);
+		CPPUNIT_ASSERT_EQUAL(size_t(2), mac.received.size());
+		CPPUNIT_ASSERT(mac.received.at(1).get() == original);
+		CPPUNIT_ASSERT_EQUAL(3.0, original->snr);
+	}
+
+	void testSimulation() {
+		HeadlessSimulation simulation(getConfig());
+		CPPUNIT_ASSERT_EQUAL(size_t(3), simulation.getNodes().size());
+		HeadlessSimulation::Result result = simulation.run(100);
+		CPPUNIT_ASSERT_EQUAL(uint64_t(100), result.num_slots);
+		CPPUNIT_ASSERT_EQUAL(uint64_t(100), simulation.getCurrentSlot());
+		// Every node generates one packet per ten slots, and DelayMac sends every tenth slot.
+		CPPUNIT_ASSERT_EQUAL(size_t(30), result.num_generated);
+		CPPUNIT_ASSERT_EQUAL(size_t(30), result.num_transmitted);
+		// All nodes are within range of each other.
+		CPPUNIT_ASSERT_EQUAL(size_t(60), result.num_received);
+		CPPUNIT_ASSERT(result.wall_seconds > 0.0);
+		CPPUNIT_ASSERT(result.getPacketsPerSecond() > 0.0);
+		// Results only count the latest run.
+		result = simulation.run(10);
+		CPPUNIT_ASSERT_EQUAL(size_t(3), result.num_transmitted);
+
+		HeadlessSimulation::Config config = getConfig();
+		config.num_nodes = 0;
+		CPPUNIT_ASSERT_THROW(HeadlessSimulation{config}, std::invalid_argument);
+	}
+
+	void testReproducible() {
+		HeadlessSimulation::Config config = getConfig();
+		config.num_nodes = 50;
+		config.area_side = 200000.0;
+		config.traffic = "bernoulli:0.05";
+		config.seed = 5;
+		HeadlessSimulation first(config), second(config);
+		const HeadlessSimulation::Result first_result = first.run(200), second_result = second.run(200);
+		CPPUNIT_ASSERT(first_result.num_generated > 0);
+		CPPUNIT_ASSERT_EQUAL(first_result.num_generated, second_result.num_generated);
+		CPPUNIT_ASSERT_EQUAL(first_result.num_transmitted, second_result.num_transmitted);
+		CPPUNIT_ASSERT_EQUAL(first_result.num_received, second_result.num_received);
+		for (size_t i = 0; i < config.num_nodes; i++) {
+			const SimulatorPosition& position = first.getNodes().at(i)->getRadio().getPosition();
+			CPPUNIT_ASSERT_EQUAL(position.x, second.getNodes().at(i)->getRadio().getPosition().x);
+			CPPUNIT_ASSERT(position.x >= 0.0 && position.x <= config.area_side);
+		}
+	}
+
+	void testParallel() {
+		HeadlessSimulation::Config config = getConfig();
+		config.num_nodes = 200;
+		config.area_side = 200000.0;
+		config.traffic = "bernoulli:0.2";
+		config.seed = 3;
+		HeadlessSimulation sequential(config);
+		config.num_threads = 4;
+		HeadlessSimulation parallel(config);
+		const HeadlessSimulation::Result sequential_result = sequential.run(300), parallel_result = parallel.run(300);
+		CPPUNIT_ASSERT(sequential_result.num_received > 0);
+		CPPUNIT_ASSERT_EQUAL(sequential_result.num_generated, parallel_result.num_generated);
+		CPPUNIT_ASSERT_EQUAL(sequential_result.num_transmitted, parallel_result.num_transmitted);
+		CPPUNIT_ASSERT_EQUAL(sequential_result.num_received, parallel_result.num_received);
+		for (size_t i = 0; i < config.num_nodes; i++)
+			CPPUNIT_ASSERT_EQUAL(sequential.getNodes().at(i)->getNumReceived(), parallel.getNodes().at(i)->getNumReceived());
+	}
+
+	void testConcurrentRelease() {
+		SlotExecutor executor(4);
+		const size_t num_receivers = 8;
+		for (size_t round = 0; round < 200; round++) {
+			auto* original = new L2Packet();
+			original->addMessage(new L2HeaderSH(MacId(2)), nullptr);
+			std::vector<L2PacketReception> receptions;
+			{
+				const L2PacketReception shared = L2PacketReception(original);
+				for (size_t i = 0; i < num_receivers; i++) {
+					receptions.push_back(shared);
+					receptions.back().descriptor.snr = (double) i;
+				}
+			}
+			std::vector<std::unique_ptr<L2Packet>> released = std::vector<std::unique_ptr<L2Packet>>(num_receivers);
+			executor.forEach(num_receivers, [&](size_t i) {
+				released.at(i).reset(receptions.at(i).release());
+			});
+			// Exactly one receiver may have taken the original, all others hold their own copies.
+			size_t num_originals = 0;
+			for (size_t i = 0; i < num_receivers; i++) {
+				CPPUNIT_ASSERT_EQUAL((double) i, released.at(i)->snr);
+				CPPUNIT_ASSERT_EQUAL(size_t(1), released.at(i)->getHeaders().size());
+				num_originals += released.at(i).get() == original;
+			}
+			CPPUNIT_ASSERT(num_originals <= 1);
+		}
+	}
+
+	CPPUNIT_TEST_SUITE(HeadlessSimulationTests);
+		CPPUNIT_TEST(testTrafficGenerators);
+		CPPUNIT_TEST(testPassThroughRlcReleasesPackets);
+		CPPUNIT_TEST(testDelayMac);
+		CPPUNIT_TEST(testSharedReception);
+		CPPUNIT_TEST(testSimulation);
+		CPPUNIT_TEST(testReproducible);
+		CPPUNIT_TEST(testParallel);
+		CPPUNIT_TEST(testConcurrentRelease);
+	CPPUNIT_TEST_SUITE_END();
+};
@@ -0,0 +1,134 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <map>
+#include <vector>
+#include "../IOmnetPluggable.hpp"
+#include "../Statistic.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class IOmnetSinkTests : public CppUnit::TestFixture {
+private:
+	class TestSink : public IOmnetSink {
+	public:
+		double getTime() override {
+			return 42.0;
+		}
+
+		void scheduleAt(double time) override {
+			scheduled.push_back(time);
+		}
+
+		void onSignalRegistered(SignalHandle handle, const std::string& event_name) override {
+			names[handle] = event_name;
+		}
+
+		void emit(SignalHandle handle, double value) override {
+			emitted.emplace_back(names.at(handle), value);
+		}
+
+		bool isDebugEnabled() const override {
+			return true;
+		}
+
+		void debug(const std::string& message) override {
+			messages.push_back(message);
+		}
+
+		void deletePacket(L2Packet* packet) override {
+			delete packet;
+			num_deleted++;
+		}
+
+		SimulatorPosition getHostPosition() override {
+			return SimulatorPosition(1, 2, 3);
+		}
+
+		std::vector<double> scheduled;
+		std::map<SignalHandle, std::string> names;
+		std::vector<std::pair<std::string, double>> emitted;
+		std::vector<std::string> messages;
+		size_t num_deleted = 0;
+	};
+
+	IOmnetPluggable* pluggable;
+	TestSink* sink;
+
+public:
+	void setUp() override {
+		pluggable = new IOmnetPluggable();
+		sink = new TestSink();
+	}
+
+	void tearDown() override {
+		delete pluggable;
+		delete sink;
+	}
+
+	void testSinkReplacesCallbacks() {
+		size_t num_callback_calls = 0;
+		pluggable->registerGetTimeCallback([&num_callback_calls]() { num_callback_calls++; return 1.0; });
+		pluggable->registerEmitEventCallback([&num_callback_calls](std::string, double) { num_callback_calls++; });
+		pluggable->registerDebugMessageCallback([&num_callback_calls](std::string) { num_callback_calls++; });
+		// Callbacks work as before while no sink is set.
+		CPPUNIT_ASSERT_EQUAL(1.0, pluggable->getTime());
+		CPPUNIT_ASSERT(pluggable->isDebugEnabled());
+		CPPUNIT_ASSERT_EQUAL(size_t(1), num_callback_calls);
+
+		pluggable->setSink(sink);
+		CPPUNIT_ASSERT(pluggable->getSink() == sink);
+		CPPUNIT_ASSERT_EQUAL(42.0, pluggable->getTime());
+		pluggable->scheduleAt(43.0);
+		pluggable->debug("message");
+		pluggable->emit("signal", 5.0);
+		pluggable->deletePacket(new L2Packet());
+		CPPUNIT_ASSERT_EQUAL(3.0, pluggable->getHostPosition().z);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), num_callback_calls);
+		CPPUNIT_ASSERT_EQUAL(43.0, sink->scheduled.at(0));
+		CPPUNIT_ASSERT_EQUAL(std::string("message"), sink->messages.at(0));
+		CPPUNIT_ASSERT_EQUAL(std::string("signal"), sink->emitted.at(0).first);
+		CPPUNIT_ASSERT_EQUAL(5.0, sink->emitted.at(0).second);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), sink->num_deleted);
+
+		pluggable->setSink(nullptr);
+		CPPUNIT_ASSERT_EQUAL(1.0, pluggable->getTime());
+	}
+
+	void testSignalRegistration() {
+		// Statistics registered before the sink is set are reported when it is.
+		Statistic before = Statistic("before", pluggable);
+		pluggable->setSink(sink);
+		Statistic after = Statistic("after", pluggable);
+		CPPUNIT_ASSERT_EQUAL(size_t(2), sink->names.size());
+		before.capture(1.0);
+		after.capture(2.0);
+		before.update();
+		after.update();
+		// Emissions go to the sink right away, there is nothing to flush.
+		CPPUNIT_ASSERT_EQUAL(size_t(2), sink->emitted.size());
+		CPPUNIT_ASSERT_EQUAL(std::string("before"), sink->emitted.at(0).first);
+		CPPUNIT_ASSERT_EQUAL(std::string("after"), sink->emitted.at(1).first);
+		CPPUNIT_ASSERT_EQUAL(2.0, sink->emitted.at(1).second);
+	}
+
+	CPPUNIT_TEST_SUITE(IOmnetSinkTests);
+		CPPUNIT_TEST(testSinkReplacesCallbacks);
+		CPPUNIT_TEST(testSignalRegistration);
+	CPPUNIT_TEST_SUITE_END();
+};
@@ -0,0 +1,200 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <vector>
+#include "../L2HeaderCodec.hpp"
+#include "../BitStream.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class L2HeaderCodecTests : public CppUnit::TestFixture {
+private:
+	std::vector<uint8_t> buffer = std::vector<uint8_t>(1024, 0xFF);
+
+	L2HeaderSH makeHeaderSH() {
+		L2HeaderSH header = L2HeaderSH(MacId(42));
+		header.slot_offset = 13;
+		header.slot_duration = SlotDuration::twelve_ms;
+		header.position = CPRPosition(SimulatorPosition(1.5, -2.25, 1000.0));
+		header.time_src = 5;
+		header.num_hops = 3;
+		header.time_tx = -17;
+		header.request_time_rx = true;
+		header.is_pkt_end = true;
+		header.link_status.direction.SouthWest = true;
+		header.link_status.datarates = 123456;
+		header.link_utilizations.emplace_back(100, SlotDuration::six_ms, 1, 2, 5, 511, 255);
+		header.link_utilizations.emplace_back(5, SlotDuration::twentyfour_ms, 3, 0, 1, 7, 1);
+		LinkProposal proposal;
+		proposal.slot_offset = 16383;
+		proposal.period = 7;
+		proposal.center_frequency = 300;
+		proposal.num_tx_initiator = 2;
+		proposal.num_tx_recipient = 3;
+		header.link_proposals.emplace_back(proposal);
+		header.link_proposals.back().noise = 9;
+		header.link_requests.emplace_back(MacId(7), proposal, 987654321);
+		header.link_reply = L2HeaderSH::LinkReply(SYMBOLIC_LINK_ID_BROADCAST, proposal);
+		header.link_reply.type = 2;
+		return header;
+	}
+
+public:
+	void testBitStream() {
+		BitWriter writer = BitWriter(buffer.data(), buffer.size());
+		writer.write(5, 3);
+		writer.write(0xABCDEF0123456789, 64);
+		writer.writeBool(true);
+		writer.write((uint64_t) -3 & 0x1F, 5);
+		CPPUNIT_ASSERT_EQUAL(size_t(3 + 64 + 1 + 5), writer.getPosition());
+		BitReader reader = BitReader(buffer.data(), buffer.size());
+		CPPUNIT_ASSERT_EQUAL(uint64_t(5), reader.read(3));
+		CPPUNIT_ASSERT_EQUAL(uint64_t(0xABCDEF0123456789), reader.read(64));
+		CPPUNIT_ASSERT_EQUAL(true, reader.readBool());
+		CPPUNIT_ASSERT_EQUAL(int64_t(-3), reader.readSigned(5));
+		BitWriter small_writer = BitWriter(buffer.data(), 1);
+		CPPUNIT_ASSERT_THROW(small_writer.write(0, 9), std::out_of_range);
+	}
+
+	void testRoundTripSH() {
+		L2HeaderSH header = makeHeaderSH();
+		unsigned int num_bits = L2HeaderCodec::encode(header, buffer.data(), buffer.size());
+		CPPUNIT_ASSERT_EQUAL(L2HeaderCodec::getEncodedBits(header), num_bits);
+		CPPUNIT_ASSERT_EQUAL(L2HeaderCodec::getEncodedBits((const L2Header&) header), num_bits);
+		// Only the per-proposal and per-request extension follows the on-air section.
+		CPPUNIT_ASSERT_EQUAL(header.getBits() + 16 + 80, num_bits);
+		CPPUNIT_ASSERT_EQUAL(L2Header::FrameType::broadcast, L2HeaderCodec::peekFrameType(buffer.data(), buffer.size()));
+
+		L2HeaderSH decoded;
+		CPPUNIT_ASSERT_EQUAL(num_bits, L2HeaderCodec::decode(buffer.data(), L2HeaderCodec::getEncodedBytes(header), decoded));
+		CPPUNIT_ASSERT(header.src_id == decoded.src_id);
+		CPPUNIT_ASSERT_EQUAL(header.slot_offset, decoded.slot_offset);
+		CPPUNIT_ASSERT_EQUAL(header.slot_duration, decoded.slot_duration);
+		CPPUNIT_ASSERT_EQUAL(header.position.encodedPosition.y, decoded.position.encodedPosition.y);
+		CPPUNIT_ASSERT_EQUAL(header.time_src, decoded.time_src);
+		CPPUNIT_ASSERT_EQUAL(header.num_hops, decoded.num_hops);
+		CPPUNIT_ASSERT_EQUAL(header.time_tx, decoded.time_tx);
+		CPPUNIT_ASSERT_EQUAL(true, decoded.request_time_rx);
+		CPPUNIT_ASSERT_EQUAL(false, decoded.response_time_rx);
+		CPPUNIT_ASSERT_EQUAL(true, decoded.is_pkt_end);
+		CPPUNIT_ASSERT_EQUAL(true, decoded.link_status.direction.SouthWest);
+		CPPUNIT_ASSERT_EQUAL(false, decoded.link_status.direction.North);
+		CPPUNIT_ASSERT_EQUAL(header.link_status.datarates, decoded.link_status.datarates);
+		CPPUNIT_ASSERT_EQUAL(2, decoded.link_status.num_utilizations);
+		CPPUNIT_ASSERT_EQUAL(1, decoded.link_status.num_proposals);
+		CPPUNIT_ASSERT_EQUAL(size_t(2), decoded.link_utilizations.size());
+		for (size_t i = 0; i < header.link_utilizations.size(); i++) {
+			const auto &expected = header.link_utilizations.at(i), &actual = decoded.link_utilizations.at(i);
+			CPPUNIT_ASSERT_EQUAL(expected.slot_offset, actual.slot_offset);
+			CPPUNIT_ASSERT_EQUAL(expected.slot_duration, actual.slot_duration);
+			CPPUNIT_ASSERT_EQUAL(expected.num_bursts_forward, actual.num_bursts_forward);
+			CPPUNIT_ASSERT_EQUAL(expected.num_bursts_reverse, actual.num_bursts_reverse);
+			CPPUNIT_ASSERT_EQUAL(expected.period, actual.period);
+			CPPUNIT_ASSERT_EQUAL(expected.center_frequency, actual.center_frequency);
+			CPPUNIT_ASSERT_EQUAL(expected.timeout, actual.timeout);
+		}
+		CPPUNIT_ASSERT_EQUAL(size_t(1), decoded.link_proposals.size());
+		CPPUNIT_ASSERT(header.link_proposals.at(0).proposed_link == decoded.link_proposals.at(0).proposed_link);
+		CPPUNIT_ASSERT_EQUAL(9, decoded.link_proposals.at(0).noise);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), decoded.link_requests.size());
+		CPPUNIT_ASSERT(MacId(7) == decoded.link_requests.at(0).dest_id);
+		CPPUNIT_ASSERT(header.link_requests.at(0).proposed_link == decoded.link_requests.at(0).proposed_link);
+		CPPUNIT_ASSERT_EQUAL(uint64_t(987654321), decoded.link_requests.at(0).generation_time);
+		CPPUNIT_ASSERT(header.link_reply == decoded.link_reply);
+	}
+
+	void testEmptySHMatchesGetBits() {
+		L2HeaderSH header = L2HeaderSH(MacId(1));
+		header.link_utilizations.emplace_back(1, SlotDuration::six_ms);
+		CPPUNIT_ASSERT_EQUAL(header.getBits(), L2HeaderCodec::encode(header, buffer.data(), buffer.size()));
+		CPPUNIT_ASSERT_THROW(L2HeaderCodec::encode(header, buffer.data(), header.getBits() / 8 - 1), std::out_of_range);
+	}
+
+	void testOutOfRangeField() {
+		L2HeaderSH header = L2HeaderSH(MacId(1));
+		header.num_hops = 16;
+		CPPUNIT_ASSERT_THROW(L2HeaderCodec::encode(header, buffer.data(), buffer.size()), std::invalid_argument);
+		header.num_hops = 0;
+		// The 4-bit count fields limit the link messages, which the SH's containers enforce.
+		for (int i = 0; i < 15; i++)
+			header.link_utilizations.emplace_back(i, SlotDuration::six_ms);
+		CPPUNIT_ASSERT_THROW(header.link_utilizations.emplace_back(15, SlotDuration::six_ms), std::length_error);
+		CPPUNIT_ASSERT_NO_THROW(L2HeaderCodec::encode(header, buffer.data(), buffer.size()));
+		// No field limits the link requests.
+		for (int i = 0; i < 20; i++)
+			header.link_requests.emplace_back(MacId(i), LinkProposal());
+		L2HeaderCodec::encode(header, buffer.data(), buffer.size());
+		L2HeaderSH decoded;
+		L2HeaderCodec::decode(buffer.data(), buffer.size(), decoded);
+		CPPUNIT_ASSERT_EQUAL(size_t(20), decoded.link_requests.size());
+		CPPUNIT_ASSERT(MacId(19) == decoded.link_requests.back().dest_id);
+	}
+
+	void testRoundTripPP() {
+		L2HeaderPP header = L2HeaderPP(MacId(99), true, SequenceNumber(50), SequenceNumber(51), 7);
+		header.src_id = MacId(3);
+		header.is_pkt_start = true;
+		header.srej_bitmap[10] = true;
+		header.srej[2] = true;
+		header.payload_length = 1200;
+		header.payload_offset = 400;
+		header.packet_id = 77;
+		unsigned int num_bits = L2HeaderCodec::encode((const L2Header&) header, buffer.data(), buffer.size());
+		CPPUNIT_ASSERT_EQUAL(L2HeaderCodec::getEncodedBits(header), num_bits);
+
+		unsigned int num_bits_read = 0;
+		L2Header* decoded_header = L2HeaderCodec::decode(buffer.data(), buffer.size(), &num_bits_read);
+		CPPUNIT_ASSERT_EQUAL(num_bits, num_bits_read);
+		CPPUNIT_ASSERT_EQUAL(L2Header::FrameType::unicast, decoded_header->frame_type);
+		auto* decoded = (L2HeaderPP*) decoded_header;
+		CPPUNIT_ASSERT(MacId(3) == decoded->src_id);
+		CPPUNIT_ASSERT(MacId(99) == decoded->dest_id);
+		CPPUNIT_ASSERT_EQUAL(true, decoded->use_arq);
+		CPPUNIT_ASSERT_EQUAL(true, decoded->is_pkt_start);
+		CPPUNIT_ASSERT_EQUAL(false, decoded->is_pkt_end);
+		CPPUNIT_ASSERT(decoded->seqno == header.seqno);
+		CPPUNIT_ASSERT(decoded->seqno_next_expected == header.seqno_next_expected);
+		CPPUNIT_ASSERT_EQUAL(7u, decoded->arq_ack_slot);
+		CPPUNIT_ASSERT(header.srej_bitmap == decoded->srej_bitmap);
+		CPPUNIT_ASSERT(header.srej == decoded->srej);
+		CPPUNIT_ASSERT_EQUAL(header.payload_length, decoded->payload_length);
+		CPPUNIT_ASSERT_EQUAL(header.payload_offset, decoded->payload_offset);
+		CPPUNIT_ASSERT_EQUAL(header.packet_id, decoded->packet_id);
+		delete decoded_header;
+
+		L2HeaderSH header_sh;
+		CPPUNIT_ASSERT_THROW(L2HeaderCodec::decode(buffer.data(), buffer.size(), header_sh), std::invalid_argument);
+	}
+
+	void testDMEHeaders() {
+		L2HeaderDMERequest request;
+		CPPUNIT_ASSERT_EQUAL(3u, L2HeaderCodec::encode((const L2Header&) request, buffer.data(), buffer.size()));
+		L2Header* decoded = L2HeaderCodec::decode(buffer.data(), buffer.size());
+		CPPUNIT_ASSERT(decoded->isDMERequest());
+		delete decoded;
+	}
+
+CPPUNIT_TEST_SUITE(L2HeaderCodecTests);
+		CPPUNIT_TEST(testBitStream);
+		CPPUNIT_TEST(testRoundTripSH);
+		CPPUNIT_TEST(testEmptySHMatchesGetBits);
+		CPPUNIT_TEST(testOutOfRangeField);
+		CPPUNIT_TEST(testRoundTripPP);
+		CPPUNIT_TEST(testDMEHeaders);
+	CPPUNIT_TEST_SUITE_END();
+};
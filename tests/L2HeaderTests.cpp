@@ -18,6 +18,8 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <iostream>
 #include "../L2Header.hpp"
+#include "../L2HeaderVisitor.hpp"
+#include "../PassThroughArq.hpp"
 
 using namespace TUHH_INTAIRNET_MCSOTDMA;
 
@@ -95,9 +97,123 @@ public:
 
 	}	
 
+	struct TypeNameVisitor {
+		std::string operator()(const L2HeaderSH&) const { return "SH"; }
+		std::string operator()(const L2HeaderPP&) const { return "PP"; }
+		std::string operator()(const L2HeaderDMERequest&) const { return "DME_REQ"; }
+		std::string operator()(const L2Header&) const { return "L2Header"; }
+	};
+
+	/** Collects the types of incoming headers the way an ARQ's receive path would. */
+	class HeaderTypeArq : public PassThroughArq {
+	public:
+		void process(L2Packet* packet) {
+			processIncomingHeader(packet);
+		}
+
+		std::vector<std::string> types;
+
+	protected:
+		void processIncomingHeader(L2Packet* incoming_packet) override {
+			visitHeaders(incoming_packet, [this](const auto& header) { types.push_back(TypeNameVisitor()(header)); });
+		}
+	};
+
+	void testArqVisitsHeaders() {
+		L2Packet packet;
+		packet.addMessage(new L2HeaderSH(MacId(1)), nullptr);
+		packet.addMessage(new L2HeaderPP(MacId(2)), nullptr);
+		packet.addMessage(nullptr, nullptr);
+		packet.addMessage(new L2HeaderDMEResponse(), nullptr);
+		HeaderTypeArq arq;
+		arq.process(&packet);
+		CPPUNIT_ASSERT_EQUAL(size_t(3), arq.types.size());
+		CPPUNIT_ASSERT_EQUAL(std::string("SH"), arq.types.at(0));
+		CPPUNIT_ASSERT_EQUAL(std::string("PP"), arq.types.at(1));
+		CPPUNIT_ASSERT_EQUAL(std::string("L2Header"), arq.types.at(2));
+	}
+
+	void testVisit() {
+		L2HeaderSH header_sh = L2HeaderSH();
+		L2HeaderPP header_pp = L2HeaderPP(MacId(99));
+		L2HeaderDMERequest header_dme_request = L2HeaderDMERequest();
+		L2HeaderDMEResponse header_dme_response = L2HeaderDMEResponse();
+		CPPUNIT_ASSERT_EQUAL(std::string("SH"), visit((const L2Header&) header_sh, TypeNameVisitor()));
+		CPPUNIT_ASSERT_EQUAL(std::string("PP"), visit((const L2Header&) header_pp, TypeNameVisitor()));
+		CPPUNIT_ASSERT_EQUAL(std::string("DME_REQ"), visit((const L2Header&) header_dme_request, TypeNameVisitor()));
+		// Types without an overload fall back to the L2Header one.
+		CPPUNIT_ASSERT_EQUAL(std::string("L2Header"), visit((const L2Header&) header_dme_response, TypeNameVisitor()));
+		CPPUNIT_ASSERT_EQUAL(std::string("L2Header"), visit((const L2Header&) *header, TypeNameVisitor()));
+		// Mutable headers can be modified through generic lambdas.
+		L2Header& base = header_pp;
+		visit(base, [](auto& concrete) { concrete.setSizeObserver(nullptr); });
+		unsigned int bits = visit(base, [](const auto& concrete) { return concrete.getBits(); });
+		CPPUNIT_ASSERT_EQUAL(header_pp.getBits(), bits);
+	}
+
+	void testInlineLinkMessages() {
+		L2HeaderSH header_sh = L2HeaderSH(MacId(1));
+		CPPUNIT_ASSERT_EQUAL(size_t(15), header_sh.link_requests.capacity());
+		for (int i = 0; i < 5; i++)
+			header_sh.link_utilizations.emplace_back(i, SlotDuration::six_ms);
+		header_sh.link_utilizations.erase(header_sh.link_utilizations.begin() + 1, header_sh.link_utilizations.begin() + 3);
+		CPPUNIT_ASSERT_EQUAL(size_t(3), header_sh.link_utilizations.size());
+		CPPUNIT_ASSERT_EQUAL(3, header_sh.link_utilizations.at(1).slot_offset);
+		header_sh.link_utilizations.insert(header_sh.link_utilizations.begin(), header_sh.link_utilizations.back());
+		CPPUNIT_ASSERT_EQUAL(4, header_sh.link_utilizations.front().slot_offset);
+		CPPUNIT_ASSERT_EQUAL(4, header_sh.link_utilizations.back().slot_offset);
+		CPPUNIT_ASSERT_THROW(header_sh.link_utilizations.at(4), std::out_of_range);
+		// Copies hold their own elements.
+		L2HeaderSH copy = L2HeaderSH(header_sh);
+		header_sh.link_utilizations.clear();
+		CPPUNIT_ASSERT_EQUAL(size_t(4), copy.link_utilizations.size());
+		CPPUNIT_ASSERT_EQUAL(0, copy.link_utilizations.at(1).slot_offset);
+		CPPUNIT_ASSERT_EQUAL(header_sh.getBits() + 4 * L2HeaderSH::LinkUtilizationMessage::getBits(), copy.getBits());
+		copy.link_utilizations.resize(15);
+		CPPUNIT_ASSERT_THROW(copy.link_utilizations.push_back(L2HeaderSH::LinkUtilizationMessage()), std::length_error);
+	}
+
+	void testGrowableLinkRequests() {
+		L2HeaderSH header_sh = L2HeaderSH(MacId(1));
+		const unsigned int bits = header_sh.getBits();
+		// No field limits the number of link requests, so they move to the heap beyond the inline capacity.
+		for (int i = 0; i < 40; i++)
+			header_sh.link_requests.emplace_back(MacId(i), LinkProposal());
+		CPPUNIT_ASSERT_EQUAL(size_t(40), header_sh.link_requests.size());
+		CPPUNIT_ASSERT(header_sh.link_requests.capacity() >= 40);
+		CPPUNIT_ASSERT(MacId(39) == header_sh.link_requests.back().dest_id);
+		CPPUNIT_ASSERT_EQUAL(bits + 40 * L2HeaderSH::LinkRequest::getBits(), header_sh.getBits());
+		header_sh.link_requests.insert(header_sh.link_requests.begin(), header_sh.link_requests.back());
+		CPPUNIT_ASSERT(MacId(39) == header_sh.link_requests.front().dest_id);
+		L2HeaderSH copy = L2HeaderSH(header_sh);
+		CPPUNIT_ASSERT_EQUAL(size_t(41), copy.link_requests.size());
+		CPPUNIT_ASSERT(MacId(20) == copy.link_requests.at(21).dest_id);
+		// Conversions from and to std::vector.
+		std::vector<L2HeaderSH::LinkRequest> requests = header_sh.link_requests;
+		CPPUNIT_ASSERT_EQUAL(size_t(41), requests.size());
+		requests.resize(3);
+		header_sh.link_requests = requests;
+		CPPUNIT_ASSERT_EQUAL(size_t(3), header_sh.link_requests.size());
+		CPPUNIT_ASSERT_EQUAL(bits + 3 * L2HeaderSH::LinkRequest::getBits(), header_sh.getBits());
+		header_sh.link_requests.assign(copy.link_requests.begin() + 10, copy.link_requests.end());
+		CPPUNIT_ASSERT_EQUAL(size_t(31), header_sh.link_requests.size());
+		CPPUNIT_ASSERT(MacId(9) == header_sh.link_requests.front().dest_id);
+		// A fixed-size container rejects a range that doesn't fit without changing its elements.
+		header_sh.link_utilizations.emplace_back(1, SlotDuration::six_ms);
+		const std::vector<L2HeaderSH::LinkUtilizationMessage> utilizations = std::vector<L2HeaderSH::LinkUtilizationMessage>(16);
+		CPPUNIT_ASSERT_THROW(header_sh.link_utilizations.assign(utilizations.begin(), utilizations.end()), std::length_error);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), header_sh.link_utilizations.size());
+		header_sh.link_utilizations.assign(utilizations.begin(), utilizations.begin() + 15);
+		CPPUNIT_ASSERT_EQUAL(size_t(15), header_sh.link_utilizations.size());
+	}
+
 CPPUNIT_TEST_SUITE(L2HeaderTests);
 		CPPUNIT_TEST(testHeader);		
 		CPPUNIT_TEST(testBroadcastHeader);
 		CPPUNIT_TEST(testUnicastHeader);
+		CPPUNIT_TEST(testVisit);
+		CPPUNIT_TEST(testArqVisitsHeaders);
+		CPPUNIT_TEST(testInlineLinkMessages);
+		CPPUNIT_TEST(testGrowableLinkRequests);
 	CPPUNIT_TEST_SUITE_END();
 };
\ No newline at end of file
@@ -18,6 +18,8 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <vector>
 #include "../L2Packet.hpp"
+#include "../L2PacketReception.hpp"
+#include "../InetPacketPayload.hpp"
 //#include "../L2PacketCallback.hpp"
 
 using namespace TUHH_INTAIRNET_MCSOTDMA;
@@ -43,6 +45,24 @@ private:
 		int some_value;
 	};
 
+	/** Counts how often its size is queried. */
+	class CountingPayload : public L2Packet::Payload {
+	public:
+		explicit CountingPayload(unsigned int bits) : bits(bits) {}
+
+		unsigned int getBits() const override {
+			num_queries++;
+			return bits;
+		}
+
+		Payload* copy() const override {
+			return new CountingPayload(bits);
+		}
+
+		unsigned int bits;
+		mutable size_t num_queries = 0;
+	};
+
 	class TestCallback : public L2PacketSentCallback {
 	public:
 		void packetBeingSentCallback(TUHH_INTAIRNET_MCSOTDMA::L2Packet* packet) override {
@@ -116,10 +136,216 @@ public:
 		CPPUNIT_ASSERT_THROW(packet->erase(0), std::invalid_argument);
 	}
 
+	void testSharedReception() {
+		auto* original = new L2Packet();
+		original->addMessage(new L2HeaderSH(MacId(1)), nullptr);
+		original->addMessage(new L2HeaderPP(MacId(2)), new TestPayload(7));
+		L2PacketReception reception = L2PacketReception(original);
+		CPPUNIT_ASSERT(!reception.isShared());
+		L2PacketReception reception2 = reception, reception3 = reception;
+		CPPUNIT_ASSERT(reception.isShared());
+		CPPUNIT_ASSERT(&reception.getPacket() == &reception2.getPacket());
+		// Per-receiver fields don't touch the shared packet.
+		reception2.descriptor.snr = 12.5;
+		reception2.descriptor.hasChannelError = true;
+		CPPUNIT_ASSERT_EQUAL(0.0, reception.descriptor.snr);
+		CPPUNIT_ASSERT_EQUAL(false, reception.getPacket().hasChannelError);
+		// Writing to the packet copies it.
+		reception2.getMutablePacket().erase(0);
+		CPPUNIT_ASSERT(&reception.getPacket() != &reception2.getPacket());
+		CPPUNIT_ASSERT_EQUAL(size_t(2), reception.getPacket().getHeaders().size());
+		CPPUNIT_ASSERT_EQUAL(size_t(1), reception2.getPacket().getHeaders().size());
+		// Releasing a still-shared packet copies it, while the last reception hands over the original.
+		L2Packet* released = reception3.release();
+		CPPUNIT_ASSERT(released != original);
+		CPPUNIT_ASSERT_EQUAL(original->getBits(), released->getBits());
+		delete released;
+		reception.descriptor.receptionDist = 1000.0;
+		released = reception.release();
+		CPPUNIT_ASSERT(released == original);
+		CPPUNIT_ASSERT_EQUAL(1000.0, released->receptionDist);
+		CPPUNIT_ASSERT_THROW(reception.getPacket(), std::logic_error);
+		delete released;
+		released = reception2.release();
+		CPPUNIT_ASSERT_EQUAL(true, released->hasChannelError);
+		CPPUNIT_ASSERT_EQUAL(12.5, released->snr);
+		delete released;
+	}
+
+	void testMoveAndOwnership() {
+		L2Packet source;
+		auto header = std::unique_ptr<L2HeaderSH>(new L2HeaderSH(MacId(10)));
+		L2Header* header_ptr = header.get();
+		source.addMessage(std::move(header), nullptr);
+		source.addMessage(std::unique_ptr<L2Header>(new L2HeaderPP()), nullptr);
+		source.hasChannelError = true;
+		// Moving hands over the messages without copying them.
+		L2Packet moved(std::move(source));
+		CPPUNIT_ASSERT_EQUAL(size_t(0), source.getHeaders().size());
+		CPPUNIT_ASSERT_EQUAL(size_t(2), moved.getHeaders().size());
+		CPPUNIT_ASSERT(moved.getHeaders().at(0) == header_ptr);
+		CPPUNIT_ASSERT_EQUAL(true, moved.hasChannelError);
+		L2Packet assigned;
+		assigned.addMessage(new L2HeaderSH(), nullptr);
+		assigned = std::move(moved);
+		CPPUNIT_ASSERT_EQUAL(size_t(2), assigned.getHeaders().size());
+		CPPUNIT_ASSERT(assigned.getHeaders().at(0) == header_ptr);
+		// Clones are deep.
+		std::unique_ptr<L2Packet> clone = assigned.clone();
+		CPPUNIT_ASSERT_EQUAL(assigned.getBits(), clone->getBits());
+		CPPUNIT_ASSERT(clone->getHeaders().at(0) != header_ptr);
+		// Released messages belong to the caller.
+		auto message = assigned.releaseMessage(0);
+		CPPUNIT_ASSERT(message.first.get() == header_ptr);
+		CPPUNIT_ASSERT(message.second == nullptr);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), assigned.getHeaders().size());
+		CPPUNIT_ASSERT_THROW(assigned.releaseMessage(1), std::invalid_argument);
+		clone->addMessage(std::move(message.first), std::move(message.second));
+		CPPUNIT_ASSERT_EQUAL(size_t(3), clone->getHeaders().size());
+	}
+
+	void testDescriptors() {
+		L2Packet packet;
+		auto* sh = new L2HeaderSH(MacId(10));
+		packet.addMessage(sh, nullptr);
+		packet.addMessage(new L2HeaderPP(MacId(11)), nullptr);
+		const auto& descriptors = packet.getDescriptors();
+		CPPUNIT_ASSERT_EQUAL(size_t(2), descriptors.size());
+		CPPUNIT_ASSERT_EQUAL(L2Header::FrameType::broadcast, descriptors.at(0).frame_type);
+		CPPUNIT_ASSERT_EQUAL(false, descriptors.at(0).fixed_header_bits);
+		CPPUNIT_ASSERT_EQUAL(L2Header::FrameType::unicast, descriptors.at(1).frame_type);
+		CPPUNIT_ASSERT_EQUAL(L2HeaderPP().getBits(), descriptors.at(1).header_bits);
+		CPPUNIT_ASSERT_EQUAL(true, packet.empty());
+		CPPUNIT_ASSERT_EQUAL(false, packet.isDME());
+		CPPUNIT_ASSERT_EQUAL(SYMBOLIC_LINK_ID_BROADCAST, packet.getDestination());
+		// The SH's size follows its contents.
+		unsigned int bits = packet.getBits();
+		sh->link_utilizations.push_back(L2HeaderSH::LinkUtilizationMessage());
+		CPPUNIT_ASSERT_EQUAL(bits + L2HeaderSH::LinkUtilizationMessage::getBits(), packet.getBits());
+		packet.erase(0);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), packet.getDescriptors().size());
+		CPPUNIT_ASSERT_EQUAL(MacId(11), packet.getDestination());
+		packet.addMessage(new L2HeaderDMERequest(), nullptr);
+		CPPUNIT_ASSERT_EQUAL(true, packet.isDME());
+	}
+
+	void testCachedBits() {
+		auto* packet = new L2Packet();
+		auto* sh = new L2HeaderSH(MacId(10));
+		packet->addMessage(sh, nullptr);
+		packet->addMessage(new L2HeaderPP(MacId(11)), nullptr);
+		unsigned int bits = sh->getBits() + L2HeaderPP().getBits();
+		CPPUNIT_ASSERT_EQUAL(bits, packet->getBits());
+		// Changes to the SH's link messages invalidate the cached size.
+		sh->link_requests.emplace_back(MacId(11), LinkProposal());
+		bits += L2HeaderSH::LinkRequest::getBits();
+		CPPUNIT_ASSERT_EQUAL(bits, packet->getBits());
+		sh->link_requests.clear();
+		bits -= L2HeaderSH::LinkRequest::getBits();
+		CPPUNIT_ASSERT_EQUAL(bits, packet->getBits());
+		// A moved-to packet observes the headers.
+		L2Packet moved(std::move(*packet));
+		delete packet;
+		sh->link_proposals.push_back(L2HeaderSH::LinkProposalMessage());
+		bits += L2HeaderSH::LinkProposalMessage::getBits();
+		CPPUNIT_ASSERT_EQUAL(bits, moved.getBits());
+		// Copies don't notify the original packet.
+		L2HeaderSH sh_copy = L2HeaderSH(*sh);
+		sh_copy.link_proposals.clear();
+		CPPUNIT_ASSERT_EQUAL(bits, moved.getBits());
+		moved.erase(1);
+		CPPUNIT_ASSERT_EQUAL(sh->getBits(), moved.getBits());
+		// Released headers no longer notify.
+		auto message = moved.releaseMessage(0);
+		CPPUNIT_ASSERT_EQUAL(0u, moved.getBits());
+		message.first.reset();
+		CPPUNIT_ASSERT_EQUAL(0u, moved.getBits());
+	}
+
+	void testMutablePayloadBits() {
+		L2Packet packet;
+		packet.addMessage(new L2HeaderSH(MacId(10)), nullptr);
+		auto* payload = new InetPacketPayload();
+		packet.addMessage(new L2HeaderPP(MacId(11)), payload);
+		const unsigned int header_bits = packet.getBits();
+		CPPUNIT_ASSERT_EQUAL(true, packet.empty());
+		// An INET payload is resized after it was added, e.g. when it is fragmented.
+		payload->size = 512;
+		CPPUNIT_ASSERT_EQUAL(header_bits + 512, packet.getBits());
+		CPPUNIT_ASSERT_EQUAL(false, packet.empty());
+		CPPUNIT_ASSERT(packet.print().find("P(512)") != std::string::npos);
+		payload->size = 0;
+		CPPUNIT_ASSERT_EQUAL(header_bits, packet.getBits());
+		CPPUNIT_ASSERT_EQUAL(true, packet.empty());
+	}
+
+	void testRunningPayloadTotal() {
+		L2Packet packet;
+		auto* sh = new L2HeaderSH(MacId(10));
+		auto* fixed = new CountingPayload(100);
+		auto* inet = new InetPacketPayload();
+		packet.addMessage(sh, fixed);
+		packet.addMessage(new L2HeaderPP(MacId(11)), inet);
+		packet.addMessage(new L2HeaderPP(MacId(12)), new CountingPayload(20));
+		unsigned int bits = sh->getBits() + 2 * L2HeaderPP().getBits() + 120;
+		CPPUNIT_ASSERT_EQUAL(bits, packet.getBits());
+		// Mutate both a header and a resizable payload.
+		sh->link_utilizations.push_back(L2HeaderSH::LinkUtilizationMessage());
+		inet->size = 64;
+		bits += L2HeaderSH::LinkUtilizationMessage::getBits() + 64;
+		CPPUNIT_ASSERT_EQUAL(bits, packet.getBits());
+		CPPUNIT_ASSERT_EQUAL(false, packet.empty());
+		// Fixed-size payloads are only asked for their size when they are added.
+		const size_t num_queries = fixed->num_queries;
+		packet.getBits();
+		packet.empty();
+		CPPUNIT_ASSERT_EQUAL(num_queries, fixed->num_queries);
+		// Erasing a message before the INET payload keeps tracking it.
+		packet.erase(0);
+		bits = 2 * L2HeaderPP().getBits() + 64 + 20;
+		CPPUNIT_ASSERT_EQUAL(bits, packet.getBits());
+		inet->size = 32;
+		CPPUNIT_ASSERT_EQUAL(bits - 32, packet.getBits());
+		packet.erase(0);
+		CPPUNIT_ASSERT_EQUAL(L2HeaderPP().getBits() + 20, packet.getBits());
+		packet.erase(0);
+		CPPUNIT_ASSERT_EQUAL(true, packet.empty());
+		CPPUNIT_ASSERT_EQUAL(0u, packet.getBits());
+	}
+
+	void testReplacePayload() {
+		L2Packet packet;
+		packet.addMessage(new L2HeaderPP(MacId(11)), nullptr);
+		packet.addMessage(new L2HeaderPP(MacId(12)), new CountingPayload(20));
+		CPPUNIT_ASSERT_EQUAL(2 * L2HeaderPP().getBits() + 20, packet.getBits());
+		// Downstream MACs write payloads into the packet directly.
+		auto* inet = new InetPacketPayload();
+		inet->size = 8;
+		packet.getPayloads().at(0) = inet;
+		delete packet.getPayloads().at(1);
+		packet.getPayloads().at(1) = nullptr;
+		CPPUNIT_ASSERT_EQUAL(2 * L2HeaderPP().getBits() + 8, packet.getBits());
+		CPPUNIT_ASSERT_EQUAL(true, packet.getDescriptors().at(0).has_payload);
+		CPPUNIT_ASSERT_EQUAL(false, packet.getDescriptors().at(0).fixed_payload_bits);
+		CPPUNIT_ASSERT_EQUAL(false, packet.getDescriptors().at(1).has_payload);
+		inet->size = 0;
+		CPPUNIT_ASSERT_EQUAL(true, packet.empty());
+		packet.erase(1);
+		packet.addMessage(new L2HeaderPP(MacId(13)), new CountingPayload(4));
+		CPPUNIT_ASSERT_EQUAL(2 * L2HeaderPP().getBits() + 4, packet.getBits());
+	}
+
 CPPUNIT_TEST_SUITE(L2PacketTests);		
 		CPPUNIT_TEST(testCallback);
 		CPPUNIT_TEST(testCopy);
 		CPPUNIT_TEST(testPacketSize);
 		CPPUNIT_TEST(testErase);
+		CPPUNIT_TEST(testSharedReception);
+		CPPUNIT_TEST(testMoveAndOwnership);
+		CPPUNIT_TEST(testDescriptors);
+		CPPUNIT_TEST(testCachedBits);
+		CPPUNIT_TEST(testMutablePayloadBits);
+		CPPUNIT_TEST(testRunningPayloadTotal);
+		CPPUNIT_TEST(testReplacePayload);
 	CPPUNIT_TEST_SUITE_END();
 };
\ No newline at end of file
@@ -0,0 +1,106 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <map>
+#include <random>
+#include "../NeighborPositionTable.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class NeighborPositionTableTests : public CppUnit::TestFixture {
+private:
+	NeighborPositionTable* table;
+
+public:
+	void setUp() override {
+		table = new NeighborPositionTable();
+	}
+
+	void tearDown() override {
+		delete table;
+	}
+
+	void testUpdateAndFind() {
+		CPPUNIT_ASSERT(table->find(MacId(1)) == nullptr);
+		table->update(MacId(1), CPRPosition(1, 2, 3, false), CPRPosition::PositionQuality::low);
+		table->update(MacId(2), CPRPosition(4, 5, 6, true), CPRPosition::PositionQuality::hi);
+		CPPUNIT_ASSERT_EQUAL(size_t(2), table->size());
+		const auto* entry = table->find(MacId(1));
+		CPPUNIT_ASSERT(entry != nullptr);
+		CPPUNIT_ASSERT(CPRPosition(1, 2, 3, false) == entry->position);
+		CPPUNIT_ASSERT_EQUAL(CPRPosition::PositionQuality::low, entry->quality);
+		// Updating an existing entry overwrites it.
+		table->update(MacId(1), CPRPosition(7, 8, 9, false), CPRPosition::PositionQuality::med);
+		CPPUNIT_ASSERT_EQUAL(size_t(2), table->size());
+		CPPUNIT_ASSERT(CPRPosition(7, 8, 9, false) == table->find(MacId(1))->position);
+		CPPUNIT_ASSERT_EQUAL(CPRPosition::PositionQuality::med, table->find(MacId(1))->quality);
+		CPPUNIT_ASSERT(table->find(MacId(3)) == nullptr);
+		CPPUNIT_ASSERT(!table->contains(SYMBOLIC_ID_UNSET));
+		size_t num_entries = 0;
+		for (const auto& it : *table) {
+			CPPUNIT_ASSERT(it.getMacId() == MacId(1) || it.getMacId() == MacId(2));
+			num_entries++;
+		}
+		CPPUNIT_ASSERT_EQUAL(size_t(2), num_entries);
+	}
+
+	/** Compares against std::map through many insertions and removals, which exercises growth and backward-shift deletion. */
+	void testAgainstMap() {
+		std::map<int, double> reference;
+		std::mt19937 generator = std::mt19937(42);
+		std::uniform_int_distribution<int> id_dist = std::uniform_int_distribution<int>(-4, 2000);
+		for (int i = 0; i < 20000; i++) {
+			int id = id_dist(generator);
+			if (generator() % 3 == 0) {
+				CPPUNIT_ASSERT_EQUAL(reference.erase(id) == 1, table->erase(MacId(id)));
+			} else {
+				reference[id] = i;
+				table->update(MacId(id), CPRPosition(i, 0, 0, false), CPRPosition::PositionQuality::hi);
+			}
+		}
+		CPPUNIT_ASSERT_EQUAL(reference.size(), table->size());
+		for (int id = -4; id <= 2000; id++) {
+			const auto* entry = table->find(MacId(id));
+			auto it = reference.find(id);
+			CPPUNIT_ASSERT_EQUAL(it != reference.end(), entry != nullptr);
+			if (entry != nullptr)
+				CPPUNIT_ASSERT_EQUAL(it->second, entry->position.latitude);
+		}
+		table->clear();
+		CPPUNIT_ASSERT(table->empty());
+		CPPUNIT_ASSERT(table->find(MacId(5)) == nullptr);
+		CPPUNIT_ASSERT(!table->erase(MacId(5)));
+	}
+
+	void testReserve() {
+		table->reserve(100);
+		table->update(MacId(1), CPRPosition(), CPRPosition::PositionQuality::hi);
+		const auto* first = table->find(MacId(1));
+		for (int id = 2; id <= 100; id++)
+			table->update(MacId(id), CPRPosition(), CPRPosition::PositionQuality::hi);
+		// Reserved entries don't reallocate.
+		CPPUNIT_ASSERT(first == table->find(MacId(1)));
+		CPPUNIT_ASSERT_EQUAL(size_t(100), table->size());
+	}
+
+CPPUNIT_TEST_SUITE(NeighborPositionTableTests);
+		CPPUNIT_TEST(testUpdateAndFind);
+		CPPUNIT_TEST(testAgainstMap);
+		CPPUNIT_TEST(testReserve);
+	CPPUNIT_TEST_SUITE_END();
+};
@@ -0,0 +1,168 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "../PerSlotStatistics.hpp"
+#include "../IMac.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class PerSlotStatisticsTests : public CppUnit::TestFixture {
+private:
+	class TestMac : public IMac {
+	public:
+		explicit TestMac(const MacId& id) : IMac(id) {}
+		void notifyOutgoing(unsigned long, const MacId&) override {}
+		void passToLower(L2Packet*, unsigned int) override {}
+		void receiveFromLower(L2Packet*, uint64_t) override {}
+		void passToUpper(L2Packet*) override {}
+		bool isGoingToTransmitDuringCurrentSlot(uint64_t) const override { return false; }
+		void setSilent(bool) override {}
+		void setCurrentSlot(uint64_t slot) { current_slot = slot; }
+	};
+
+	/** Exposes the positions' addresses. */
+	class InspectableRing : public PerSlotStatisticsRing {
+	public:
+		explicit InspectableRing(size_t capacity) : PerSlotStatisticsRing(capacity) {}
+		size_t getPositionDistance() const {
+			return (size_t) (reinterpret_cast<const char*>(&tail) - reinterpret_cast<const char*>(&head));
+		}
+	};
+
+	const std::string filename = "per_slot_statistics_test.bin";
+
+	std::vector<PerSlotRecord> readFile() const {
+		std::vector<PerSlotRecord> records;
+		std::ifstream file = std::ifstream(filename, std::ios::binary);
+		PerSlotRecord record;
+		while (file.read(reinterpret_cast<char*>(&record), sizeof(PerSlotRecord)))
+			records.push_back(record);
+		return records;
+	}
+
+public:
+	void tearDown() override {
+		std::remove(filename.c_str());
+	}
+
+	void testRing() {
+		PerSlotStatisticsRing ring(5);
+		CPPUNIT_ASSERT_EQUAL(size_t(8), ring.capacity());
+		PerSlotRecord record;
+		CPPUNIT_ASSERT(!ring.tryPop(record));
+		for (uint64_t slot = 0; slot < 8; slot++)
+			CPPUNIT_ASSERT(ring.tryPush(PerSlotRecord(slot, 1, 2, slot * 0.5)));
+		// A full buffer drops instead of blocking.
+		CPPUNIT_ASSERT(!ring.tryPush(PerSlotRecord(8, 1, 2, 0.0)));
+		CPPUNIT_ASSERT_EQUAL(uint64_t(1), ring.getNumDropped());
+		CPPUNIT_ASSERT_EQUAL(size_t(8), ring.size());
+		// Wrap around.
+		for (uint64_t slot = 0; slot < 20; slot++) {
+			CPPUNIT_ASSERT(ring.tryPop(record));
+			CPPUNIT_ASSERT_EQUAL(slot, record.slot);
+			CPPUNIT_ASSERT_EQUAL(slot * 0.5, record.value);
+			CPPUNIT_ASSERT(ring.tryPush(PerSlotRecord(slot + 8, 1, 2, (slot + 8) * 0.5)));
+		}
+		CPPUNIT_ASSERT_EQUAL(size_t(8), ring.size());
+		CPPUNIT_ASSERT_THROW(PerSlotStatisticsRing(0), std::invalid_argument);
+		// Wherever the heap places the ring, head and tail cannot share a cache line.
+		std::unique_ptr<InspectableRing> heap_ring = std::unique_ptr<InspectableRing>(new InspectableRing(4));
+		CPPUNIT_ASSERT(heap_ring->getPositionDistance() >= 64);
+	}
+
+	void testConcurrentProducerAndConsumer() {
+		PerSlotStatisticsRing ring(64);
+		const uint64_t num_records = 100000;
+		std::thread producer = std::thread([&ring, num_records] {
+			for (uint64_t slot = 0; slot < num_records; slot++)
+				while (!ring.tryPush(PerSlotRecord(slot, 0, 0, 0.0)))
+					std::this_thread::yield();
+		});
+		uint64_t expected = 0;
+		PerSlotRecord record;
+		bool in_order = true;
+		while (expected < num_records) {
+			if (ring.tryPop(record)) {
+				in_order = in_order && record.slot == expected;
+				expected++;
+			} else
+				std::this_thread::yield();
+		}
+		producer.join();
+		CPPUNIT_ASSERT(in_order);
+		CPPUNIT_ASSERT_EQUAL(size_t(0), ring.size());
+	}
+
+	void testMacWritesToFile() {
+		TestMac mac = TestMac(MacId(7));
+		// Nothing is recorded while capturing is disabled.
+		mac.capturePerSlotStatistic(1, 1.0);
+		CPPUNIT_ASSERT(mac.getPerSlotStatistics() == nullptr);
+		CPPUNIT_ASSERT_THROW(mac.writePerSlotStatisticsTo(filename), std::runtime_error);
+
+		mac.shouldCapturePerSlotStatistics(true, 1024);
+		mac.writePerSlotStatisticsTo(filename);
+		const uint64_t num_slots = 5000;
+		for (uint64_t slot = 0; slot < num_slots; slot++) {
+			mac.setCurrentSlot(slot);
+			mac.capturePerSlotStatistic(3, slot * 2.0);
+		}
+		mac.stopWritingPerSlotStatistics();
+
+		const uint64_t num_dropped = mac.getPerSlotStatistics()->getNumDropped();
+		std::vector<PerSlotRecord> records = readFile();
+		CPPUNIT_ASSERT_EQUAL(num_slots - num_dropped, (uint64_t) records.size());
+		uint64_t last_slot = 0;
+		for (size_t i = 0; i < records.size(); i++) {
+			CPPUNIT_ASSERT_EQUAL(int32_t(7), records.at(i).mac_id);
+			CPPUNIT_ASSERT_EQUAL(uint32_t(3), records.at(i).kind);
+			CPPUNIT_ASSERT_EQUAL(records.at(i).slot * 2.0, records.at(i).value);
+			CPPUNIT_ASSERT(i == 0 || records.at(i).slot > last_slot);
+			last_slot = records.at(i).slot;
+		}
+
+		// Disabling stops the capture but keeps the buffer.
+		mac.shouldCapturePerSlotStatistics(false);
+		mac.capturePerSlotStatistic(3, 0.0);
+		CPPUNIT_ASSERT_EQUAL(size_t(0), mac.getPerSlotStatistics()->size());
+	}
+
+	void testCopiedMac() {
+		TestMac mac = TestMac(MacId(7));
+		mac.shouldCapturePerSlotStatistics(true, 16);
+		TestMac copy = TestMac(mac);
+		// The copy doesn't share the single-producer buffer and captures nothing.
+		CPPUNIT_ASSERT(copy.getPerSlotStatistics() == nullptr);
+		CPPUNIT_ASSERT_NO_THROW(copy.capturePerSlotStatistic(1, 1.0));
+		CPPUNIT_ASSERT_EQUAL(size_t(0), mac.getPerSlotStatistics()->size());
+		copy.shouldCapturePerSlotStatistics(true, 16);
+		copy.capturePerSlotStatistic(1, 1.0);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), copy.getPerSlotStatistics()->size());
+	}
+
+	CPPUNIT_TEST_SUITE(PerSlotStatisticsTests);
+		CPPUNIT_TEST(testRing);
+		CPPUNIT_TEST(testConcurrentProducerAndConsumer);
+		CPPUNIT_TEST(testMacWritesToFile);
+		CPPUNIT_TEST(testCopiedMac);
+	CPPUNIT_TEST_SUITE_END();
+};
@@ -0,0 +1,88 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "../ReceiverBank.hpp"
+#include "../ReservationPhy.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class ReceiverBankTests : public CppUnit::TestFixture {
+private:
+	class TestPhy : public ReservationPhy {
+	public:
+		explicit TestPhy(size_t num_receivers) : ReservationPhy(num_receivers) {}
+		TestPhy() = default;
+		void receiveFromUpper(L2Packet*, unsigned int) override {}
+		unsigned long getCurrentDatarate() const override { return 0; }
+	};
+
+public:
+	void testTuning() {
+		ReceiverBank bank = ReceiverBank(3);
+		CPPUNIT_ASSERT_EQUAL(size_t(3), bank.getNumReceivers());
+		CPPUNIT_ASSERT(!bank.isTunedTo(1000));
+		CPPUNIT_ASSERT_EQUAL(ReceiverBank::unknown_channel, bank.getChannelIndex(1000));
+		CPPUNIT_ASSERT_EQUAL(size_t(0), bank.tune(1000));
+		CPPUNIT_ASSERT_EQUAL(size_t(1), bank.tune(2000));
+		// Two receivers may share a frequency.
+		CPPUNIT_ASSERT_EQUAL(size_t(2), bank.tune(1000));
+		CPPUNIT_ASSERT(bank.isTunedTo(1000));
+		CPPUNIT_ASSERT(bank.isTunedTo(2000));
+		CPPUNIT_ASSERT(!bank.isTunedTo(3000));
+		CPPUNIT_ASSERT_EQUAL(uint64_t(2000), bank.getFrequency(1));
+		CPPUNIT_ASSERT_THROW(bank.tune(3000), std::runtime_error);
+		CPPUNIT_ASSERT_EQUAL(size_t(0), bank.getChannelIndex(1000));
+		CPPUNIT_ASSERT_EQUAL(size_t(1), bank.getChannelIndex(2000));
+
+		bank.clear();
+		CPPUNIT_ASSERT_EQUAL(size_t(0), bank.getNumTuned());
+		CPPUNIT_ASSERT(!bank.isTunedTo(1000));
+		CPPUNIT_ASSERT(!bank.isTunedTo(2000));
+		CPPUNIT_ASSERT_THROW(bank.getFrequency(0), std::out_of_range);
+		// Channel indices are kept across slots.
+		CPPUNIT_ASSERT_EQUAL(size_t(0), bank.tune(2000));
+		CPPUNIT_ASSERT_EQUAL(size_t(1), bank.getChannelIndex(2000));
+		CPPUNIT_ASSERT(bank.isTunedTo(2000));
+		CPPUNIT_ASSERT(!bank.isTunedTo(1000));
+		CPPUNIT_ASSERT_THROW(ReceiverBank(0), std::invalid_argument);
+	}
+
+	void testPhyReceivers() {
+		TestPhy default_phy;
+		CPPUNIT_ASSERT_EQUAL(size_t(2), default_phy.getNumReceivers());
+		TestPhy phy = TestPhy(4);
+		CPPUNIT_ASSERT_EQUAL(size_t(4), phy.getNumReceivers());
+		for (uint64_t frequency = 1; frequency <= 4; frequency++)
+			phy.tuneReceiver(frequency * 1000);
+		CPPUNIT_ASSERT_THROW(phy.tuneReceiver(5000), std::runtime_error);
+		CPPUNIT_ASSERT(phy.isTunedTo(3000));
+		CPPUNIT_ASSERT(!phy.isTunedTo(5000));
+		// Every receiver has its own reservations.
+		phy.getReceiverReservations(3).reserve(0);
+		CPPUNIT_ASSERT_THROW(phy.getReceiverReservations(4), std::out_of_range);
+		phy.update(1);
+		CPPUNIT_ASSERT(!phy.isTunedTo(3000));
+		CPPUNIT_ASSERT_NO_THROW(phy.tuneReceiver(5000));
+		CPPUNIT_ASSERT(phy.isTunedTo(5000));
+	}
+
+	CPPUNIT_TEST_SUITE(ReceiverBankTests);
+		CPPUNIT_TEST(testTuning);
+		CPPUNIT_TEST(testPhyReceivers);
+	CPPUNIT_TEST_SUITE_END();
+};
@@ -0,0 +1,138 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <memory>
+#include <vector>
+#include "../ReferenceChannel.hpp"
+#include "../ReservationPhy.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class ReferenceChannelTests : public CppUnit::TestFixture {
+private:
+	/** Keeps every packet it receives. */
+	class TestPhy : public ReservationPhy {
+	public:
+		void receiveFromUpper(L2Packet* data, unsigned int center_frequency) override {
+			radio->sendToChannel(data, center_frequency);
+		}
+
+		unsigned long getCurrentDatarate() const override { return 0; }
+
+		void onSharedReception(L2PacketReception reception, uint64_t) override {
+			descriptors.push_back(reception.descriptor);
+			packets.emplace_back(reception.release());
+		}
+
+		std::vector<ReceptionDescriptor> descriptors;
+		std::vector<std::unique_ptr<L2Packet>> packets;
+	};
+
+	/** SNR falls by one dB per meter. */
+	class LinearPathLoss : public PathLossModel {
+	public:
+		double getSnr(double distance, uint64_t) const override {
+			return 100.0 - distance;
+		}
+	};
+
+	ReferenceChannel* channel;
+	std::vector<std::unique_ptr<ReferenceRadio>> radios;
+	std::vector<std::unique_ptr<TestPhy>> phys;
+
+	void addNode(int id, const SimulatorPosition& position) {
+		radios.emplace_back(new ReferenceRadio(*channel, MacId(id), position));
+		phys.emplace_back(new TestPhy());
+		radios.back()->setPhy(phys.back().get());
+		phys.back()->setRadio(radios.back().get());
+	}
+
+public:
+	void setUp() override {
+		channel = new ReferenceChannel(50.0, std::unique_ptr<PathLossModel>(new LinearPathLoss()));
+		addNode(0, SimulatorPosition(0, 0, 0));
+		addNode(1, SimulatorPosition(30, 0, 0));
+		addNode(2, SimulatorPosition(0, 40, 30));
+		addNode(3, SimulatorPosition(100, 0, 0));
+	}
+
+	void tearDown() override {
+		radios.clear();
+		phys.clear();
+		delete channel;
+	}
+
+	void testBroadcastWithinRange() {
+		for (auto& phy : phys)
+			phy->tuneReceiver(1000);
+		phys.at(0)->receiveFromUpper(new L2Packet(), 1000);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), channel->getNumPending());
+		CPPUNIT_ASSERT_EQUAL(size_t(2), channel->deliver());
+		CPPUNIT_ASSERT_EQUAL(size_t(0), channel->getNumPending());
+		// Not to the sender itself, nor to node 3 out of range.
+		CPPUNIT_ASSERT(phys.at(0)->packets.empty());
+		CPPUNIT_ASSERT(phys.at(3)->packets.empty());
+		CPPUNIT_ASSERT_EQUAL(size_t(1), phys.at(1)->packets.size());
+		CPPUNIT_ASSERT_EQUAL(size_t(1), phys.at(2)->packets.size());
+		CPPUNIT_ASSERT(phys.at(1)->packets.at(0).get() != phys.at(2)->packets.at(0).get());
+		CPPUNIT_ASSERT_EQUAL(30.0, phys.at(1)->descriptors.at(0).receptionDist);
+		CPPUNIT_ASSERT_EQUAL(70.0, phys.at(1)->descriptors.at(0).snr);
+		CPPUNIT_ASSERT_EQUAL(50.0, phys.at(2)->descriptors.at(0).receptionDist);
+		CPPUNIT_ASSERT_EQUAL(50.0, phys.at(2)->descriptors.at(0).snr);
+		CPPUNIT_ASSERT(!phys.at(2)->descriptors.at(0).hasChannelError);
+	}
+
+	void testFrequencyAndSnrFiltering() {
+		phys.at(1)->tuneReceiver(1000);
+		phys.at(2)->tuneReceiver(2000);
+		channel->setMinimumSnr(60.0);
+		phys.at(0)->receiveFromUpper(new L2Packet(), 1000);
+		phys.at(0)->receiveFromUpper(new L2Packet(), 3000);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), channel->deliver());
+		CPPUNIT_ASSERT(phys.at(2)->packets.empty());
+		CPPUNIT_ASSERT(!phys.at(1)->descriptors.at(0).hasChannelError);
+		phys.at(2)->receiveFromUpper(new L2Packet(), 2000);
+		phys.at(0)->tuneReceiver(2000);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), channel->deliver());
+		// 50 meters apart, so 50 dB SNR.
+		CPPUNIT_ASSERT(phys.at(0)->descriptors.at(0).hasChannelError);
+	}
+
+	void testMovingAndDetaching() {
+		for (auto& phy : phys)
+			phy->tuneReceiver(1000);
+		radios.at(3)->setPosition(SimulatorPosition(10, 0, 0));
+		CPPUNIT_ASSERT_THROW(ReferenceRadio(*channel, MacId(1), SimulatorPosition()), std::invalid_argument);
+		radios.at(2).reset();
+		CPPUNIT_ASSERT_EQUAL(size_t(3), channel->getNumRadios());
+		phys.at(0)->receiveFromUpper(new L2Packet(), 1000);
+		CPPUNIT_ASSERT_EQUAL(size_t(2), channel->distribute());
+		CPPUNIT_ASSERT_EQUAL(size_t(1), radios.at(3)->getNumPending());
+		radios.at(3)->deliverPending();
+		CPPUNIT_ASSERT_EQUAL(size_t(1), phys.at(3)->packets.size());
+		CPPUNIT_ASSERT_EQUAL(10.0, phys.at(3)->descriptors.at(0).receptionDist);
+		// Undelivered packets are dropped without leaking.
+		phys.at(0)->receiveFromUpper(new L2Packet(), 1000);
+	}
+
+	CPPUNIT_TEST_SUITE(ReferenceChannelTests);
+		CPPUNIT_TEST(testBroadcastWithinRange);
+		CPPUNIT_TEST(testFrequencyAndSnrFiltering);
+		CPPUNIT_TEST(testMovingAndDetaching);
+	CPPUNIT_TEST_SUITE_END();
+};
@@ -16,6 +16,11 @@
 
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
 #include "../RngProvider.hpp"
 
 using namespace TUHH_INTAIRNET_MCSOTDMA;
@@ -30,6 +35,7 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 
 	public:
 		void setUp() override {
+			tester = nullptr;
 			RngProvider::getInstance().reset();
 		}
 
@@ -62,14 +68,190 @@ namespace TUHH_INTAIRNET_MCSOTDMA {
 			RngProvider::getInstance().setUseDefaultRngs(false);
 			tester = new TesterClass();
 			CPPUNIT_ASSERT_THROW(tester->getRandomInt(0, 1), std::runtime_error);
-			CPPUNIT_ASSERT_EQUAL(0, ((OmnetIntegerUniformRng*) RngProvider::getInstance().int_rng_callers[tester])->k);
+			CPPUNIT_ASSERT_EQUAL(0, ((OmnetIntegerUniformRng*) RngProvider::getInstance().int_rngs.at(tester->getStreamIndex()))->k);
 			TesterClass tester2 = TesterClass();
-			CPPUNIT_ASSERT_EQUAL(1, ((OmnetIntegerUniformRng*) RngProvider::getInstance().int_rng_callers[&tester2])->k);
+			CPPUNIT_ASSERT_EQUAL(1, ((OmnetIntegerUniformRng*) RngProvider::getInstance().int_rngs.at(tester2.getStreamIndex()))->k);
+		}
+
+		void testReproducibleStreams() {
+			RngProvider::getInstance().setUseDefaultRngs(true);
+			RngProvider::getInstance().setSeed(42);
+			tester = new TesterClass();
+			TesterClass other = TesterClass();
+			std::vector<int> first_run, other_stream;
+			for (size_t i = 0; i < 100; i++) {
+				first_run.push_back(tester->getRandomInt(0, 1000000));
+				other_stream.push_back(other.getRandomInt(0, 1000000));
+			}
+			CPPUNIT_ASSERT(first_run != other_stream);
+			// Signing up again in the same order with the same seed reproduces the streams.
+			delete tester;
+			RngProvider::getInstance().reset();
+			tester = new TesterClass();
+			std::vector<int> second_run;
+			for (size_t i = 0; i < 100; i++)
+				second_run.push_back(tester->getRandomInt(0, 1000000));
+			CPPUNIT_ASSERT(first_run == second_run);
+			// A different seed gives a different stream.
+			delete tester;
+			RngProvider::getInstance().reset();
+			RngProvider::getInstance().setSeed(43);
+			tester = new TesterClass();
+			std::vector<int> third_run;
+			for (size_t i = 0; i < 100; i++)
+				third_run.push_back(tester->getRandomInt(0, 1000000));
+			CPPUNIT_ASSERT(first_run != third_run);
+			RngProvider::getInstance().setSeed(0);
+		}
+
+		void testBoundedInts() {
+			IntegerUniformRng rng = IntegerUniformRng(1, 2);
+			// Every value of a small range is hit about equally often.
+			std::vector<size_t> histogram = std::vector<size_t>(7, 0);
+			const size_t num_draws = 70000;
+			for (size_t i = 0; i < num_draws; i++) {
+				int value = rng.get(-3, 4);
+				CPPUNIT_ASSERT(-3 <= value && value < 4);
+				histogram.at(value + 3)++;
+			}
+			for (size_t count : histogram)
+				CPPUNIT_ASSERT(count > 9500 && count < 10500);
+			// Full and empty ranges.
+			CPPUNIT_ASSERT_NO_THROW(rng.get(std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+			CPPUNIT_ASSERT_EQUAL(5, rng.get(5, 5));
+			CPPUNIT_ASSERT_EQUAL(5, rng.get(5, 6));
+			// Each stream is just a counter.
+			CPPUNIT_ASSERT(sizeof(IntegerUniformRng) <= 2 * sizeof(uint64_t));
+		}
+
+		void testBulkInts() {
+			RngProvider::getInstance().setUseDefaultRngs(true);
+			tester = new TesterClass();
+			std::vector<int> values = tester->getRandomInts(-5, 95, 10000);
+			CPPUNIT_ASSERT_EQUAL(size_t(10000), values.size());
+			double mean = 0.0;
+			for (int value : values) {
+				CPPUNIT_ASSERT(-5 <= value && value < 95);
+				mean += value;
+			}
+			mean /= values.size();
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(44.5, mean, 1.0);
+			// Bulk and single draws of the same stream agree while nothing is rejected, which is almost always for small ranges.
+			IntegerUniformRng bulk = IntegerUniformRng(3, 4), single = IntegerUniformRng(3, 4);
+			int bulk_values[64];
+			bulk.fill(0, 10, bulk_values, 64);
+			for (int value : bulk_values)
+				CPPUNIT_ASSERT_EQUAL(single.get(0, 10), value);
+			CPPUNIT_ASSERT_EQUAL(single.get(0, 10), bulk.get(0, 10));
+			// Ranges with frequent rejections stay in bounds.
+			const int max = (1 << 30) + 1;
+			bulk.fill(0, max, bulk_values, 64);
+			for (int value : bulk_values)
+				CPPUNIT_ASSERT(0 <= value && value < max);
+		}
+
+		void testShuffleAndSubset() {
+			RngProvider::getInstance().setUseDefaultRngs(true);
+			tester = new TesterClass();
+			std::vector<int> elements;
+			for (int i = 0; i < 50; i++)
+				elements.push_back(i);
+			std::vector<int> shuffled = elements;
+			tester->shuffle(shuffled);
+			CPPUNIT_ASSERT(shuffled != elements);
+			std::sort(shuffled.begin(), shuffled.end());
+			CPPUNIT_ASSERT(shuffled == elements);
+
+			std::vector<int> subset = tester->getRandomSubset(elements, 10);
+			CPPUNIT_ASSERT_EQUAL(size_t(10), subset.size());
+			std::sort(subset.begin(), subset.end());
+			CPPUNIT_ASSERT(std::unique(subset.begin(), subset.end()) == subset.end());
+			CPPUNIT_ASSERT(tester->getRandomSubset(elements, 0).empty());
+			CPPUNIT_ASSERT_EQUAL(size_t(50), tester->getRandomSubset(elements, 50).size());
+			CPPUNIT_ASSERT_THROW(tester->getRandomSubset(elements, 51), std::invalid_argument);
+			// Every element is picked about equally often.
+			std::vector<size_t> num_picked = std::vector<size_t>(5, 0);
+			for (size_t i = 0; i < 10000; i++)
+				for (int value : tester->getRandomSubset(std::vector<int>({0, 1, 2, 3, 4}), 2))
+					num_picked.at(value)++;
+			for (size_t count : num_picked)
+				CPPUNIT_ASSERT(count > 3700 && count < 4300);
+		}
+
+		void testPerThreadProviders() {
+			auto simulate = [](std::vector<int>* results) {
+				RngProvider provider;
+				provider.setSeed(7);
+				RngProvider::Binding binding(provider);
+				std::vector<std::unique_ptr<TesterClass>> users;
+				for (size_t i = 0; i < 100; i++)
+					users.emplace_back(new TesterClass());
+				for (size_t round = 0; round < 100; round++)
+					for (auto& user : users)
+						results->push_back(user->getRandomInt(0, 1000));
+			};
+			std::vector<int> first, second;
+			std::thread first_thread = std::thread(simulate, &first), second_thread = std::thread(simulate, &second);
+			first_thread.join();
+			second_thread.join();
+			CPPUNIT_ASSERT_EQUAL(size_t(100 * 100), first.size());
+			CPPUNIT_ASSERT(first == second);
+			// The default instance was left alone.
+			CPPUNIT_ASSERT(RngProvider::getDefaultInstance().int_rngs.empty());
+		}
+
+		void testBinding() {
+			RngProvider provider;
+			provider.setUseDefaultRngs(false);
+			provider.setOmnetGetInt([](int, int, int k) { return 100 + k; });
+			{
+				RngProvider::Binding binding(provider);
+				CPPUNIT_ASSERT(&RngProvider::getInstance() == &provider);
+				tester = new TesterClass();
+			}
+			CPPUNIT_ASSERT(&RngProvider::getInstance() == &RngProvider::getDefaultInstance());
+			// Users keep drawing from the provider they signed up with.
+			CPPUNIT_ASSERT_EQUAL(100, tester->getRandomInt(0, 1));
+			CPPUNIT_ASSERT(RngProvider::getDefaultInstance().int_rngs.empty());
+			RngProvider::bindToCurrentThread(&provider);
+			CPPUNIT_ASSERT(&RngProvider::getInstance() == &provider);
+			RngProvider::bindToCurrentThread(nullptr);
+			CPPUNIT_ASSERT(&RngProvider::getInstance() == &RngProvider::getDefaultInstance());
+			delete tester;
+			tester = nullptr;
+		}
+
+		void testStreamIndices() {
+			RngProvider::getInstance().setUseDefaultRngs(true);
+			tester = new TesterClass();
+			TesterClass second = TesterClass();
+			CPPUNIT_ASSERT_EQUAL(size_t(0), tester->getStreamIndex());
+			CPPUNIT_ASSERT_EQUAL(size_t(1), second.getStreamIndex());
+			// Signing up again keeps the stream.
+			CPPUNIT_ASSERT_EQUAL(size_t(1), RngProvider::getInstance().signupInt(&second));
+			CPPUNIT_ASSERT_EQUAL(size_t(2), RngProvider::getInstance().int_rngs.size());
+			// Indices from before a reset are rejected, even once the index is in use again.
+			RngProvider::getInstance().reset();
+			TesterClass third = TesterClass();
+			CPPUNIT_ASSERT_EQUAL(size_t(0), third.getStreamIndex());
+			CPPUNIT_ASSERT_THROW(tester->getRandomInt(0, 10), std::invalid_argument);
+			CPPUNIT_ASSERT_THROW(second.getRandomInt(0, 10), std::invalid_argument);
+			CPPUNIT_ASSERT_NO_THROW(third.getRandomInt(0, 10));
+			// Another provider's callers are rejected.
+			RngProvider other;
+			CPPUNIT_ASSERT_THROW(other.getInt(&third, 0, 10), std::invalid_argument);
 		}
 
 	CPPUNIT_TEST_SUITE(RngProviderTests);
 			CPPUNIT_TEST(testGetInts);
 			CPPUNIT_TEST(testOmnetVersion);
+			CPPUNIT_TEST(testReproducibleStreams);
+			CPPUNIT_TEST(testBoundedInts);
+			CPPUNIT_TEST(testBulkInts);
+			CPPUNIT_TEST(testShuffleAndSubset);
+			CPPUNIT_TEST(testPerThreadProviders);
+			CPPUNIT_TEST(testBinding);
+			CPPUNIT_TEST(testStreamIndices);
 		CPPUNIT_TEST_SUITE_END();
 	};
 }
\ No newline at end of file
@@ -71,9 +71,58 @@ public:
 
 	}
 
+	/** Reference implementation that steps one at a time. */
+	static uint8_t stepIncrement(uint8_t seqno) {
+		seqno = (uint8_t) ((seqno + 1) % SEQNO_MAX);
+		return seqno == SEQNO_UNSET ? stepIncrement(seqno) : seqno;
+	}
+
+	static uint8_t stepDecrement(uint8_t seqno) {
+		seqno = (uint8_t) ((seqno - 1) % SEQNO_MAX);
+		return seqno == SEQNO_UNSET ? stepDecrement(seqno) : seqno;
+	}
+
+	void testClosedFormArithmetic() {
+		for (int raw = 0; raw <= SEQNO_MAX; raw++) {
+			SequenceNumber seqno = SequenceNumber((uint8_t) raw);
+			uint8_t expected_sum = (uint8_t) raw, expected_difference = (uint8_t) raw;
+			for (int step = 1; step <= 255; step++) {
+				expected_sum = stepIncrement(expected_sum);
+				expected_difference = stepDecrement(expected_difference);
+				CPPUNIT_ASSERT_EQUAL((int) expected_sum, (int) (seqno + (uint8_t) step).get());
+				CPPUNIT_ASSERT_EQUAL((int) expected_difference, (int) (seqno - (uint8_t) step).get());
+			}
+			SequenceNumber incremented = seqno, decremented = seqno;
+			incremented.increment();
+			decremented.decrement();
+			CPPUNIT_ASSERT_EQUAL((int) stepIncrement((uint8_t) raw), (int) incremented.get());
+			CPPUNIT_ASSERT_EQUAL((int) stepDecrement((uint8_t) raw), (int) decremented.get());
+		}
+	}
+
+	void testCompareAllValues() {
+		for (int window : {0, 1, 2, 64, 100, 127, 128, 253, 254, 255}) {
+			for (int raw = 0; raw <= SEQNO_MAX; raw++) {
+				for (int other_raw = 0; other_raw <= SEQNO_MAX; other_raw++) {
+					// The loop-free comparison must match the explicit case distinction.
+					bool expected = false;
+					if (raw > other_raw && (uint8_t) (raw - other_raw) < window)
+						expected = true;
+					if (other_raw > raw && (uint8_t) ((SEQNO_MAX - other_raw) + (raw - SEQNO_FIRST)) < window)
+						expected = true;
+					SequenceNumber seqno = SequenceNumber((uint8_t) raw), other = SequenceNumber((uint8_t) other_raw);
+					CPPUNIT_ASSERT_EQUAL(expected, seqno.isHigherThan(other, (uint8_t) window));
+					CPPUNIT_ASSERT_EQUAL(expected, other.isLowerThan(seqno, (uint8_t) window));
+				}
+			}
+		}
+	}
+
 CPPUNIT_TEST_SUITE(SequenceNumberTests);
 		CPPUNIT_TEST(testModulo);
 		CPPUNIT_TEST(testCompare);
 		CPPUNIT_TEST(testArithmetic);
+		CPPUNIT_TEST(testClosedFormArithmetic);
+		CPPUNIT_TEST(testCompareAllValues);
 	CPPUNIT_TEST_SUITE_END();
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "../SlotArena.hpp"
+#include "../L2Packet.hpp"
+#include "../InetPacketPayload.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class SlotArenaTests : public CppUnit::TestFixture {
+private:
+	SlotArena* arena;
+
+	class CountingPayload : public L2Packet::Payload {
+	public:
+		explicit CountingPayload(size_t& num_destroyed) : num_destroyed(num_destroyed) {}
+
+		~CountingPayload() override {
+			num_destroyed++;
+		}
+
+		unsigned int getBits() const override {
+			return 8;
+		}
+
+		Payload* copy() const override {
+			return new CountingPayload(num_destroyed);
+		}
+
+		size_t& num_destroyed;
+	};
+
+public:
+	void setUp() override {
+		arena = new SlotArena(1024);
+	}
+
+	void tearDown() override {
+		delete arena;
+	}
+
+	void testBuildPacket() {
+		size_t num_destroyed = 0;
+		L2Packet* packet = arena->createPacket();
+		CPPUNIT_ASSERT(packet->getArena() == arena);
+		auto* header = arena->create<L2HeaderSH>(MacId(1));
+		auto* header_pp = arena->create<L2HeaderPP>(MacId(2));
+		auto* payload = arena->create<InetPacketPayload>();
+		payload->size = 100;
+		packet->addMessage(header, arena->create<CountingPayload>(num_destroyed));
+		packet->addMessage(header_pp, payload);
+		CPPUNIT_ASSERT(arena->owns(packet));
+		CPPUNIT_ASSERT(arena->owns(header));
+		CPPUNIT_ASSERT_EQUAL(header->getBits() + 8 + header_pp->getBits() + 100, packet->getBits());
+		CPPUNIT_ASSERT_EQUAL(size_t(5), arena->getNumObjects());
+		arena->reset();
+		CPPUNIT_ASSERT_EQUAL(size_t(1), num_destroyed);
+		CPPUNIT_ASSERT_EQUAL(size_t(0), arena->getNumObjects());
+	}
+
+	void testMixedOwnership() {
+		size_t num_destroyed = 0;
+		L2Packet* packet = arena->createPacket();
+		packet->addMessage(new L2HeaderSH(), new CountingPayload(num_destroyed));
+		packet->addMessage(arena->create<L2HeaderPP>(), arena->create<CountingPayload>(num_destroyed));
+		// Erasing an arena-owned message leaves its destruction to the arena.
+		packet->erase(1);
+		CPPUNIT_ASSERT_EQUAL(size_t(0), num_destroyed);
+		arena->reset();
+		// Both the heap-allocated payload and the arena-owned one have been destroyed.
+		CPPUNIT_ASSERT_EQUAL(size_t(2), num_destroyed);
+	}
+
+	void testMemoryIsReused() {
+		for (int i = 0; i < 20; i++)
+			arena->create<L2HeaderSH>();
+		size_t num_bytes = arena->getNumBytesReserved();
+		CPPUNIT_ASSERT(num_bytes > 1024);
+		for (int slot = 0; slot < 10; slot++) {
+			arena->reset();
+			for (int i = 0; i < 20; i++)
+				arena->create<L2HeaderSH>();
+		}
+		CPPUNIT_ASSERT_EQUAL(num_bytes, arena->getNumBytesReserved());
+	}
+
+	void testOversizedObject() {
+		struct Large {
+			char data[4096];
+		};
+		auto* large = arena->create<Large>();
+		CPPUNIT_ASSERT(arena->owns(large));
+		CPPUNIT_ASSERT(arena->owns(&large->data[4095]));
+		CPPUNIT_ASSERT(!arena->owns(this));
+		// Trivially destructible objects need no destruction.
+		CPPUNIT_ASSERT_EQUAL(size_t(0), arena->getNumObjects());
+	}
+
+	void testCopyLivesOnHeap() {
+		L2Packet* packet = arena->createPacket();
+		packet->addMessage(arena->create<L2HeaderSH>(MacId(5)), nullptr);
+		L2Packet* copy = packet->copy();
+		arena->reset();
+		CPPUNIT_ASSERT(copy->getArena() == nullptr);
+		CPPUNIT_ASSERT(MacId(5) == copy->getOrigin());
+		delete copy;
+	}
+
+	void testHeapPacketWithArenaMessages() {
+		size_t num_destroyed = 0;
+		auto* header = arena->create<L2HeaderSH>(MacId(3));
+		CPPUNIT_ASSERT(header->getArena() == arena);
+		auto* packet = new L2Packet();
+		packet->addMessage(header, arena->create<CountingPayload>(num_destroyed));
+		packet->addMessage(new L2HeaderPP(), new CountingPayload(num_destroyed));
+		// Releasing an arena-owned message hands out a heap copy.
+		auto released = packet->releaseMessage(0);
+		CPPUNIT_ASSERT(released.first.get() != header);
+		CPPUNIT_ASSERT(released.first->getArena() == nullptr);
+		CPPUNIT_ASSERT_EQUAL(size_t(0), num_destroyed);
+		released.second.reset();
+		CPPUNIT_ASSERT_EQUAL(size_t(1), num_destroyed);
+		packet->addMessage(arena->create<L2HeaderPP>(), arena->create<CountingPayload>(num_destroyed));
+		// Only the heap-allocated payload is deleted together with the packet.
+		delete packet;
+		CPPUNIT_ASSERT_EQUAL(size_t(2), num_destroyed);
+		// The arena destroys the original of the released payload, too.
+		arena->reset();
+		CPPUNIT_ASSERT_EQUAL(size_t(4), num_destroyed);
+	}
+
+	void testDestroy() {
+		size_t num_destroyed = 0;
+		L2Packet* packet = arena->createPacket();
+		packet->addMessage(new L2HeaderSH(), new CountingPayload(num_destroyed));
+		// Arena packets are left to the arena, no matter who disposes of them.
+		L2Packet::destroy(packet);
+		std::unique_ptr<L2Packet, L2Packet::Deleter>(arena->createPacket());
+		CPPUNIT_ASSERT_EQUAL(size_t(0), num_destroyed);
+		arena->reset();
+		CPPUNIT_ASSERT_EQUAL(size_t(1), num_destroyed);
+		auto* heap_packet = new L2Packet();
+		heap_packet->addMessage(new L2HeaderSH(), new CountingPayload(num_destroyed));
+		L2Packet::destroy(heap_packet);
+		CPPUNIT_ASSERT_EQUAL(size_t(2), num_destroyed);
+		L2Packet::destroy(nullptr);
+		// Copies, e.g. made by a layer that keeps a message, never belong to the arena.
+		CountingPayload copy = *arena->create<CountingPayload>(num_destroyed);
+		CPPUNIT_ASSERT(copy.getArena() == nullptr);
+		arena->reset();
+	}
+
+	CPPUNIT_TEST_SUITE(SlotArenaTests);
+		CPPUNIT_TEST(testBuildPacket);
+		CPPUNIT_TEST(testMixedOwnership);
+		CPPUNIT_TEST(testMemoryIsReused);
+		CPPUNIT_TEST(testOversizedObject);
+		CPPUNIT_TEST(testCopyLivesOnHeap);
+		CPPUNIT_TEST(testHeapPacketWithArenaMessages);
+		CPPUNIT_TEST(testDestroy);
+	CPPUNIT_TEST_SUITE_END();
+};
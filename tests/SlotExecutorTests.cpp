@@ -0,0 +1,107 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <atomic>
+#include <memory>
+#include "../SlotExecutor.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class SlotExecutorTests : public CppUnit::TestFixture {
+private:
+	std::unique_ptr<SlotExecutor> executor;
+
+public:
+	void setUp() override {
+		executor.reset(new SlotExecutor(4));
+	}
+
+	void tearDown() override {
+		executor.reset();
+	}
+
+	void testForEach() {
+		CPPUNIT_ASSERT_EQUAL(size_t(4), executor->getNumThreads());
+		const size_t num_tasks = 1000;
+		std::vector<std::atomic<int>> num_calls(num_tasks);
+		for (auto& value : num_calls)
+			value = 0;
+		for (int round = 1; round <= 3; round++) {
+			executor->forEach(num_tasks, [&num_calls](size_t i) {num_calls[i]++;});
+			for (size_t i = 0; i < num_tasks; i++)
+				CPPUNIT_ASSERT_EQUAL(round, num_calls[i].load());
+		}
+		// Fewer tasks than threads.
+		executor->forEach(1, [&num_calls](size_t i) {num_calls[i]++;});
+		CPPUNIT_ASSERT_EQUAL(4, num_calls[0].load());
+		executor->forEach(0, [](size_t) {throw std::logic_error("no tasks");});
+	}
+
+	void testPhasesAreSeparated() {
+		const size_t num_nodes = 500;
+		std::vector<int> transmitted(num_nodes, 0);
+		std::atomic<size_t> num_incomplete(0);
+		size_t num_exchanges = 0;
+		for (int slot = 1; slot <= 20; slot++) {
+			executor->runSlot(num_nodes, [&transmitted, slot](size_t i) {
+				transmitted[i] = slot;
+			}, [&num_exchanges]() {
+				num_exchanges++;
+			}, [&transmitted, &num_incomplete, slot, num_nodes](size_t i) {
+				// Every node's transmit phase must have finished, including those that other threads handled.
+				for (size_t j = 0; j < num_nodes; j += 7)
+					if (transmitted[(i + j) % num_nodes] != slot)
+						num_incomplete++;
+			});
+		}
+		CPPUNIT_ASSERT_EQUAL(size_t(0), num_incomplete.load());
+		CPPUNIT_ASSERT_EQUAL(size_t(20), num_exchanges);
+		// The exchange may be empty.
+		executor->runSlot(num_nodes, [](size_t) {}, nullptr, [](size_t) {});
+	}
+
+	void testExceptions() {
+		std::atomic<size_t> num_calls(0);
+		CPPUNIT_ASSERT_THROW(executor->forEach(100, [&num_calls](size_t i) {
+			num_calls++;
+			if (i == 42)
+				throw std::runtime_error("failure");
+		}), std::runtime_error);
+		// All other calls still finish, and the pool remains usable.
+		CPPUNIT_ASSERT_EQUAL(size_t(100), num_calls.load());
+		num_calls = 0;
+		executor->forEach(100, [&num_calls](size_t) {num_calls++;});
+		CPPUNIT_ASSERT_EQUAL(size_t(100), num_calls.load());
+	}
+
+	void testSingleThread() {
+		SlotExecutor single(1);
+		CPPUNIT_ASSERT_EQUAL(size_t(1), single.getNumThreads());
+		std::vector<size_t> order;
+		single.forEach(5, [&order](size_t i) {order.push_back(i);});
+		CPPUNIT_ASSERT(order == std::vector<size_t>({0, 1, 2, 3, 4}));
+		CPPUNIT_ASSERT_THROW(SlotExecutor(0), std::invalid_argument);
+	}
+
+	CPPUNIT_TEST_SUITE(SlotExecutorTests);
+		CPPUNIT_TEST(testForEach);
+		CPPUNIT_TEST(testPhasesAreSeparated);
+		CPPUNIT_TEST(testExceptions);
+		CPPUNIT_TEST(testSingleThread);
+	CPPUNIT_TEST_SUITE_END();
+};
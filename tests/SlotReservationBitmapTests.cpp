@@ -0,0 +1,152 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <random>
+#include <vector>
+#include "../SlotReservationBitmap.hpp"
+#include "../ReservationPhy.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class SlotReservationBitmapTests : public CppUnit::TestFixture {
+private:
+	class TestPhy : public ReservationPhy {
+	public:
+		explicit TestPhy(size_t reservation_horizon = 1024) : ReservationPhy(2, reservation_horizon) {}
+		void receiveFromUpper(L2Packet*, unsigned int) override {}
+		unsigned long getCurrentDatarate() const override { return 0; }
+	};
+
+public:
+	void testReserveAndRelease() {
+		SlotReservationBitmap bitmap = SlotReservationBitmap(100);
+		CPPUNIT_ASSERT_EQUAL(size_t(128), bitmap.getHorizon());
+		CPPUNIT_ASSERT(bitmap.isIdle(0, 128));
+		// Crosses a word boundary.
+		bitmap.reserve(60, 10);
+		CPPUNIT_ASSERT(bitmap.isIdle(0, 60));
+		CPPUNIT_ASSERT(!bitmap.isIdle(0, 61));
+		CPPUNIT_ASSERT(!bitmap.isIdle(69, 1));
+		CPPUNIT_ASSERT(bitmap.isIdle(70, 58));
+		CPPUNIT_ASSERT(bitmap.isReserved(65));
+		bitmap.release(62, 3);
+		CPPUNIT_ASSERT(bitmap.isIdle(62, 3));
+		CPPUNIT_ASSERT(bitmap.isReserved(61));
+		CPPUNIT_ASSERT(bitmap.isReserved(65));
+		CPPUNIT_ASSERT_THROW(bitmap.isIdle(100, 29), std::out_of_range);
+		CPPUNIT_ASSERT_THROW(bitmap.reserve(128), std::out_of_range);
+		CPPUNIT_ASSERT_NO_THROW(bitmap.isIdle(127, 1));
+		CPPUNIT_ASSERT(bitmap.isIdle(10, 0));
+	}
+
+	void testAdvance() {
+		SlotReservationBitmap bitmap = SlotReservationBitmap(64);
+		bitmap.reserve(0, 5);
+		bitmap.reserve(63);
+		bitmap.advance(3);
+		CPPUNIT_ASSERT(bitmap.isReserved(0));
+		CPPUNIT_ASSERT(bitmap.isReserved(1));
+		CPPUNIT_ASSERT(!bitmap.isReserved(2));
+		CPPUNIT_ASSERT(bitmap.isReserved(60));
+		// Slots that wrapped around to the end of the window are free.
+		CPPUNIT_ASSERT(bitmap.isIdle(61, 3));
+		// Reservations across the wrap-around.
+		bitmap.reserve(58, 6);
+		CPPUNIT_ASSERT(!bitmap.isIdle(63, 1));
+		bitmap.advance(1000);
+		CPPUNIT_ASSERT(bitmap.isIdle(0, 64));
+	}
+
+	void testAgainstReference() {
+		std::mt19937 generator = std::mt19937(3);
+		SlotReservationBitmap bitmap = SlotReservationBitmap(256);
+		// Reference indexed by absolute slot.
+		std::vector<bool> reference = std::vector<bool>(100000, false);
+		uint64_t current_slot = 0;
+		for (size_t step = 0; step < 20000; step++) {
+			const unsigned int offset = generator() % 200, num_slots = generator() % 57;
+			switch (generator() % 4) {
+				case 0:
+					bitmap.reserve(offset, num_slots);
+					for (unsigned int i = 0; i < num_slots; i++)
+						reference.at(current_slot + offset + i) = true;
+					break;
+				case 1:
+					bitmap.release(offset, num_slots);
+					for (unsigned int i = 0; i < num_slots; i++)
+						reference.at(current_slot + offset + i) = false;
+					break;
+				case 2: {
+					bool expected = true;
+					for (unsigned int i = 0; i < num_slots; i++)
+						expected = expected && !reference.at(current_slot + offset + i);
+					CPPUNIT_ASSERT_EQUAL(expected, bitmap.isIdle(offset, num_slots));
+					break;
+				}
+				default: {
+					const unsigned int num_advanced = generator() % 5;
+					bitmap.advance(num_advanced);
+					current_slot += num_advanced;
+				}
+			}
+		}
+		for (unsigned int offset = 0; offset < 256; offset++)
+			CPPUNIT_ASSERT_EQUAL((bool) reference.at(current_slot + offset), bitmap.isReserved(offset));
+	}
+
+	void testPhyIdleQueries() {
+		TestPhy phy;
+		CPPUNIT_ASSERT(phy.isTransmitterIdle(0, 10));
+		CPPUNIT_ASSERT(phy.isAnyReceiverIdle(0, 10));
+		phy.getTransmitterReservations().reserve(5, 2);
+		CPPUNIT_ASSERT(!phy.isTransmitterIdle(0, 10));
+		CPPUNIT_ASSERT(phy.isTransmitterIdle(7, 10));
+		phy.getReceiverReservations(0).reserve(0, 10);
+		CPPUNIT_ASSERT(phy.isAnyReceiverIdle(0, 10));
+		phy.getReceiverReservations(1).reserve(9);
+		CPPUNIT_ASSERT(!phy.isAnyReceiverIdle(0, 10));
+		CPPUNIT_ASSERT(phy.isAnyReceiverIdle(10, 10));
+		CPPUNIT_ASSERT_THROW(phy.getReceiverReservations(2), std::out_of_range);
+		phy.update(9);
+		CPPUNIT_ASSERT(phy.isTransmitterIdle(0, 100));
+		CPPUNIT_ASSERT(!phy.isAnyReceiverIdle(0, 1));
+		CPPUNIT_ASSERT(phy.isAnyReceiverIdle(1, 100));
+		// Tuning a receiver reserves it for the current slot.
+		phy.update(1);
+		phy.tuneReceiver(1000);
+		CPPUNIT_ASSERT(phy.isAnyReceiverIdle(0, 1));
+		phy.tuneReceiver(2000);
+		CPPUNIT_ASSERT(!phy.isAnyReceiverIdle(0, 1));
+		CPPUNIT_ASSERT(phy.isAnyReceiverIdle(1, 1));
+		phy.update(1);
+		CPPUNIT_ASSERT(phy.isAnyReceiverIdle(0, 1));
+		// The horizon is configurable.
+		TestPhy long_phy = TestPhy(4096);
+		CPPUNIT_ASSERT_EQUAL(size_t(4096), long_phy.getTransmitterReservations().getHorizon());
+		CPPUNIT_ASSERT_EQUAL(size_t(4096), long_phy.getReceiverReservations(1).getHorizon());
+		CPPUNIT_ASSERT_NO_THROW(long_phy.getTransmitterReservations().reserve(4000));
+		CPPUNIT_ASSERT(!long_phy.isTransmitterIdle(4000, 1));
+	}
+
+	CPPUNIT_TEST_SUITE(SlotReservationBitmapTests);
+		CPPUNIT_TEST(testReserveAndRelease);
+		CPPUNIT_TEST(testAdvance);
+		CPPUNIT_TEST(testAgainstReference);
+		CPPUNIT_TEST(testPhyIdleQueries);
+	CPPUNIT_TEST_SUITE_END();
+};
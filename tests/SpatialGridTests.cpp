@@ -0,0 +1,185 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
+#include <random>
+#include "../SpatialGrid.hpp"
+#include "../IMac.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class SpatialGridTests : public CppUnit::TestFixture {
+private:
+	SpatialGrid* grid;
+	std::vector<SimulatorPosition> positions;
+
+	class TestMac : public IMac {
+	public:
+		explicit TestMac(const MacId& id) : IMac(id) {}
+		void notifyOutgoing(unsigned long, const MacId&) override {}
+		void passToLower(L2Packet*, unsigned int) override {}
+		void receiveFromLower(L2Packet*, uint64_t) override {}
+		void passToUpper(L2Packet*) override {}
+		bool isGoingToTransmitDuringCurrentSlot(uint64_t) const override { return false; }
+		void setSilent(bool) override {}
+	};
+
+	static double distance(const SimulatorPosition& a, const SimulatorPosition& b) {
+		return std::sqrt((a.x - b.x)*(a.x - b.x) + (a.y - b.y)*(a.y - b.y) + (a.z - b.z)*(a.z - b.z));
+	}
+
+	static std::vector<int> toIds(const std::vector<MacId>& ids) {
+		std::vector<int> result;
+		for (const auto& id : ids)
+			result.push_back(id.getId());
+		return result;
+	}
+
+public:
+	void setUp() override {
+		grid = new SpatialGrid(1000.0);
+		// Users spread over 20x20 km, partly at negative coordinates.
+		std::mt19937 generator = std::mt19937(7);
+		std::uniform_real_distribution<double> horizontal = std::uniform_real_distribution<double>(-10000.0, 10000.0), vertical = std::uniform_real_distribution<double>(0.0, 3000.0);
+		positions.clear();
+		for (int id = 0; id < 300; id++) {
+			positions.emplace_back(horizontal(generator), horizontal(generator), vertical(generator));
+			grid->update(MacId(id), positions.back());
+		}
+	}
+
+	void tearDown() override {
+		delete grid;
+	}
+
+	void testNeighborsWithin() {
+		const SimulatorPosition center = SimulatorPosition(500.0, -2500.0, 1000.0);
+		for (double radius : {0.0, 800.0, 2500.0, 7000.0, 50000.0}) {
+			std::vector<int> expected;
+			for (int id = 0; id < (int) positions.size(); id++)
+				if (distance(positions.at(id), center) <= radius)
+					expected.push_back(id);
+			std::vector<int> actual = toIds(grid->neighborsWithin(center, radius));
+			std::sort(actual.begin(), actual.end());
+			CPPUNIT_ASSERT(expected == actual);
+		}
+	}
+
+	void testNearest() {
+		for (const SimulatorPosition& center : {SimulatorPosition(0, 0, 0), SimulatorPosition(-9000, 9000, 500), SimulatorPosition(100000, 0, 0)}) {
+			for (size_t k : {1, 5, 40, 300, 400}) {
+				std::vector<int> expected;
+				for (int id = 0; id < (int) positions.size(); id++)
+					expected.push_back(id);
+				std::sort(expected.begin(), expected.end(), [&](int a, int b) { return distance(positions.at(a), center) < distance(positions.at(b), center); });
+				expected.resize(std::min(k, expected.size()));
+				CPPUNIT_ASSERT(expected == toIds(grid->nearest(center, k)));
+			}
+		}
+	}
+
+	void testMoveAndErase() {
+		const SimulatorPosition far_away = SimulatorPosition(500000.0, 500000.0, 0.0);
+		grid->update(MacId(3), far_away);
+		CPPUNIT_ASSERT_EQUAL(size_t(300), grid->size());
+		std::vector<int> nearest = toIds(grid->nearest(far_away, 1));
+		CPPUNIT_ASSERT_EQUAL(size_t(1), nearest.size());
+		CPPUNIT_ASSERT_EQUAL(3, nearest.at(0));
+		CPPUNIT_ASSERT(toIds(grid->neighborsWithin(positions.at(3), 0.0)).empty());
+		CPPUNIT_ASSERT(grid->erase(MacId(3)));
+		CPPUNIT_ASSERT(!grid->erase(MacId(3)));
+		CPPUNIT_ASSERT(grid->neighborsWithin(far_away, 1.0).empty());
+		CPPUNIT_ASSERT_EQUAL(size_t(299), grid->size());
+		// The remaining users are still found in their cells.
+		for (int id : {0, 4, 299})
+			CPPUNIT_ASSERT_EQUAL(id, toIds(grid->nearest(positions.at(id), 1)).at(0));
+		grid->clear();
+		CPPUNIT_ASSERT(grid->nearest(SimulatorPosition(), 3).empty());
+		CPPUNIT_ASSERT_THROW(SpatialGrid(0.0), std::invalid_argument);
+	}
+
+	/** Moves users between cells so that cells are emptied and reoccupied, which reorders the grid's cell index. */
+	void testRandomMoves() {
+		std::mt19937 generator = std::mt19937(11);
+		std::uniform_real_distribution<double> horizontal = std::uniform_real_distribution<double>(-10000.0, 10000.0);
+		std::uniform_int_distribution<int> user = std::uniform_int_distribution<int>(0, 299);
+		for (int move = 0; move < 3000; move++) {
+			const int id = user(generator);
+			positions.at(id) = SimulatorPosition(horizontal(generator), horizontal(generator), 0.0);
+			grid->update(MacId(id), positions.at(id));
+		}
+		const SimulatorPosition center = SimulatorPosition(-1200.0, 800.0, 0.0);
+		std::vector<int> expected;
+		for (int id = 0; id < (int) positions.size(); id++)
+			if (distance(positions.at(id), center) <= 3000.0)
+				expected.push_back(id);
+		std::vector<int> actual = toIds(grid->neighborsWithin(center, 3000.0));
+		std::sort(actual.begin(), actual.end());
+		CPPUNIT_ASSERT(expected == actual);
+		for (int id = 0; id < (int) positions.size(); id++)
+			CPPUNIT_ASSERT_EQUAL(id, toIds(grid->nearest(positions.at(id), 1)).at(0));
+	}
+
+	void testMacQueries() {
+		TestMac mac = TestMac(MacId(0));
+		mac.updatePosition(MacId(0), CPRPosition(SimulatorPosition(0, 0, 0)), CPRPosition::PositionQuality::hi);
+		mac.updatePosition(MacId(1), CPRPosition(SimulatorPosition(100, 0, 0)), CPRPosition::PositionQuality::hi);
+		mac.updatePosition(MacId(2), CPRPosition(SimulatorPosition(0, 300, 0)), CPRPosition::PositionQuality::hi);
+		mac.updatePosition(MacId(3), CPRPosition(SimulatorPosition(90000, 0, 0)), CPRPosition::PositionQuality::hi);
+		std::vector<int> within = toIds(mac.getNeighborsWithin(500.0));
+		std::sort(within.begin(), within.end());
+		CPPUNIT_ASSERT(std::vector<int>({1, 2}) == within);
+		CPPUNIT_ASSERT(std::vector<int>({1, 2}) == toIds(mac.getNearestNeighbors(2)));
+		CPPUNIT_ASSERT(std::vector<int>({1, 2, 3}) == toIds(mac.getNearestNeighbors(10)));
+		// Moving a neighbor updates the index.
+		mac.updatePosition(MacId(3), CPRPosition(SimulatorPosition(10, 10, 0)), CPRPosition::PositionQuality::med);
+		CPPUNIT_ASSERT(std::vector<int>({3}) == toIds(mac.getNearestNeighbors(1)));
+	}
+
+	/** Small tables are scanned linearly and large ones use the grid; both answer the same. */
+	void testMacQueriesAcrossTableSizes() {
+		for (size_t num_users : {10, 300}) {
+			TestMac mac = TestMac(MacId(0));
+			for (int id = 0; id < (int) num_users; id++)
+				mac.updatePosition(MacId(id), CPRPosition(positions.at(id)), CPRPosition::PositionQuality::hi);
+			std::vector<int> expected;
+			for (int id = 1; id < (int) num_users; id++)
+				if (distance(positions.at(id), positions.at(0)) <= 4000.0)
+					expected.push_back(id);
+			std::vector<int> within = toIds(mac.getNeighborsWithin(4000.0));
+			std::sort(within.begin(), within.end());
+			CPPUNIT_ASSERT(expected == within);
+			CPPUNIT_ASSERT(mac.getNeighborsWithin(-1.0).empty());
+			expected.clear();
+			for (int id = 1; id < (int) num_users; id++)
+				expected.push_back(id);
+			std::sort(expected.begin(), expected.end(), [&](int a, int b) { return distance(positions.at(a), positions.at(0)) < distance(positions.at(b), positions.at(0)); });
+			expected.resize(5);
+			CPPUNIT_ASSERT(expected == toIds(mac.getNearestNeighbors(5)));
+		}
+	}
+
+CPPUNIT_TEST_SUITE(SpatialGridTests);
+		CPPUNIT_TEST(testNeighborsWithin);
+		CPPUNIT_TEST(testNearest);
+		CPPUNIT_TEST(testMoveAndErase);
+		CPPUNIT_TEST(testRandomMoves);
+		CPPUNIT_TEST(testMacQueries);
+		CPPUNIT_TEST(testMacQueriesAcrossTableSizes);
+	CPPUNIT_TEST_SUITE_END();
+};
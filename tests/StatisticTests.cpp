@@ -0,0 +1,176 @@
+// The L-Band Digital Aeronautical Communications System (LDACS) Link Layer Glue Library provides interfaces and common classes necessary for the LDACS Air-Air Medium Access Control simulator.
+// Copyright (C) 2023  Sebastian Lindner, Konrad Fuger, Musab Ahmed Eltayeb Ahmed, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <vector>
+#include "../Statistic.hpp"
+#include "../DelayMac.hpp"
+#include "../PassThroughArq.hpp"
+#include "../PassThroughRlc.hpp"
+
+using namespace TUHH_INTAIRNET_MCSOTDMA;
+
+class StatisticTests : public CppUnit::TestFixture {
+private:
+	IOmnetPluggable* pluggable;
+
+public:
+	void setUp() override {
+		pluggable = new IOmnetPluggable();
+	}
+
+	void tearDown() override {
+		delete pluggable;
+	}
+
+	void testRegisterSignal() {
+		IOmnetPluggable::SignalHandle a = pluggable->registerSignal("a"), b = pluggable->registerSignal("b");
+		CPPUNIT_ASSERT(a != b);
+		CPPUNIT_ASSERT_EQUAL(a, pluggable->registerSignal("a"));
+		CPPUNIT_ASSERT_EQUAL(std::string("b"), pluggable->getSignalName(b));
+		CPPUNIT_ASSERT_THROW(pluggable->getSignalName(b + 1), std::out_of_range);
+	}
+
+	void testPerValueEmission() {
+		std::vector<std::pair<std::string, double>> emitted;
+		pluggable->registerEmitEventCallback([&emitted](std::string name, double value) { emitted.emplace_back(name, value); });
+		Statistic statistic = Statistic("mcsotdma_statistic_test", pluggable);
+		statistic.update();
+		statistic.capture(5.0);
+		statistic.update();
+		// Unchanged values aren't emitted again.
+		statistic.update();
+		CPPUNIT_ASSERT_EQUAL(size_t(2), emitted.size());
+		CPPUNIT_ASSERT_EQUAL(std::string("mcsotdma_statistic_test"), emitted.at(1).first);
+		CPPUNIT_ASSERT_EQUAL(5.0, emitted.at(1).second);
+	}
+
+	void testBatchedEmission() {
+		size_t num_calls = 0, num_per_value_calls = 0;
+		std::vector<IOmnetPluggable::SignalEmission> emitted;
+		pluggable->registerEmitEventCallback([&num_per_value_calls](std::string, double) { num_per_value_calls++; });
+		pluggable->registerEmitBatchCallback([&num_calls, &emitted](const IOmnetPluggable::SignalEmission* emissions, size_t num) {
+			num_calls++;
+			emitted.insert(emitted.end(), emissions, emissions + num);
+		});
+		Statistic first = Statistic("first", pluggable), second = Statistic("second", pluggable);
+		first.capture(1.0);
+		second.capture(2.0);
+		first.update();
+		second.update();
+		pluggable->emit("third", 3.0);
+		CPPUNIT_ASSERT_EQUAL(size_t(0), num_calls);
+		pluggable->flushEmissions();
+		CPPUNIT_ASSERT_EQUAL(size_t(1), num_calls);
+		CPPUNIT_ASSERT_EQUAL(size_t(0), num_per_value_calls);
+		CPPUNIT_ASSERT_EQUAL(size_t(3), emitted.size());
+		CPPUNIT_ASSERT_EQUAL(std::string("first"), pluggable->getSignalName(emitted.at(0).handle));
+		CPPUNIT_ASSERT_EQUAL(1.0, emitted.at(0).value);
+		CPPUNIT_ASSERT_EQUAL(std::string("second"), pluggable->getSignalName(emitted.at(1).handle));
+		CPPUNIT_ASSERT_EQUAL(std::string("third"), pluggable->getSignalName(emitted.at(2).handle));
+		// Nothing pending, so no call.
+		pluggable->flushEmissions();
+		CPPUNIT_ASSERT_EQUAL(size_t(1), num_calls);
+	}
+
+	void testBoundedBatch() {
+		size_t num_calls = 0, num_emitted = 0;
+		pluggable->registerEmitBatchCallback([&num_calls, &num_emitted](const IOmnetPluggable::SignalEmission*, size_t num) {
+			num_calls++;
+			num_emitted += num;
+		});
+		CPPUNIT_ASSERT_THROW(pluggable->setMaxPendingEmissions(0), std::invalid_argument);
+		pluggable->setMaxPendingEmissions(3);
+		Statistic statistic = Statistic("bounded", pluggable);
+		for (size_t i = 1; i <= 7; i++) {
+			statistic.capture((double) i);
+			statistic.update();
+		}
+		// A full buffer is flushed without waiting for flushEmissions().
+		CPPUNIT_ASSERT_EQUAL(size_t(2), num_calls);
+		CPPUNIT_ASSERT_EQUAL(size_t(6), num_emitted);
+		// Lowering the limit below the number of pending values flushes them.
+		pluggable->setMaxPendingEmissions(1);
+		CPPUNIT_ASSERT_EQUAL(size_t(3), num_calls);
+		CPPUNIT_ASSERT_EQUAL(size_t(7), num_emitted);
+	}
+
+	void testFlushOnSlotEnd() {
+		DelayMac mac = DelayMac(MacId(1));
+		size_t num_emitted = 0;
+		mac.registerEmitBatchCallback([&num_emitted](const IOmnetPluggable::SignalEmission*, size_t num) { num_emitted += num; });
+		mac.emit("slot_end", 1.0);
+		mac.emit("slot_end", 2.0);
+		CPPUNIT_ASSERT_EQUAL(size_t(0), num_emitted);
+		mac.onSlotEnd();
+		CPPUNIT_ASSERT_EQUAL(size_t(2), num_emitted);
+	}
+
+	void testFlushOnSlotBoundary() {
+		size_t num_emitted = 0;
+		auto count = [&num_emitted](const IOmnetPluggable::SignalEmission*, size_t num) { num_emitted += num; };
+		{
+			DelayMac mac = DelayMac(MacId(1));
+			PassThroughArq arq;
+			PassThroughRlc rlc;
+			mac.setUpperLayer(&arq);
+			arq.setUpperLayer(&rlc);
+			mac.registerEmitBatchCallback(count);
+			arq.registerEmitBatchCallback(count);
+			rlc.registerEmitBatchCallback(count);
+			mac.emit("mac", 1.0);
+			arq.emit("arq", 2.0);
+			rlc.emit("rlc", 3.0);
+			CPPUNIT_ASSERT_EQUAL(size_t(0), num_emitted);
+			// The MAC's update flushes the whole stack.
+			mac.update(1);
+			CPPUNIT_ASSERT_EQUAL(size_t(3), num_emitted);
+			// So do the ARQ's and RLC's events.
+			arq.emit("arq", 4.0);
+			arq.onEvent(0.0);
+			CPPUNIT_ASSERT_EQUAL(size_t(4), num_emitted);
+			rlc.emit("rlc", 5.0);
+			rlc.onEvent(0.0);
+			CPPUNIT_ASSERT_EQUAL(size_t(5), num_emitted);
+			mac.emit("mac", 6.0);
+			rlc.emit("rlc", 7.0);
+		}
+		// Values pending at destruction aren't lost.
+		CPPUNIT_ASSERT_EQUAL(size_t(7), num_emitted);
+		CPPUNIT_ASSERT(!IOmnetPluggable::isAnyEmissionPending());
+		// Copies take over buffered values, which keep counting as pending until both are flushed.
+		IOmnetPluggable original;
+		original.registerEmitBatchCallback(count);
+		original.emit("copied", 1.0);
+		CPPUNIT_ASSERT(IOmnetPluggable::isAnyEmissionPending());
+		IOmnetPluggable copy = IOmnetPluggable(original);
+		original.flushEmissions();
+		CPPUNIT_ASSERT(IOmnetPluggable::isAnyEmissionPending());
+		copy.flushEmissions();
+		CPPUNIT_ASSERT(!IOmnetPluggable::isAnyEmissionPending());
+		CPPUNIT_ASSERT_EQUAL(size_t(9), num_emitted);
+	}
+
+	CPPUNIT_TEST_SUITE(StatisticTests);
+		CPPUNIT_TEST(testRegisterSignal);
+		CPPUNIT_TEST(testPerValueEmission);
+		CPPUNIT_TEST(testBatchedEmission);
+		CPPUNIT_TEST(testBoundedBatch);
+		CPPUNIT_TEST(testFlushOnSlotEnd);
+		CPPUNIT_TEST(testFlushOnSlotBoundary);
+	CPPUNIT_TEST_SUITE_END();
+};
@@ -23,6 +23,19 @@
 #include "L2HeaderTests.cpp"
 #include "L2PacketTests.cpp"
 #include "RngProviderTests.cpp"
+#include "L2HeaderCodecTests.cpp"
+#include "SlotArenaTests.cpp"
+#include "NeighborPositionTableTests.cpp"
+#include "SpatialGridTests.cpp"
+#include "PerSlotStatisticsTests.cpp"
+#include "StatisticTests.cpp"
+#include "DistributionStatisticTests.cpp"
+#include "IOmnetSinkTests.cpp"
+#include "SlotReservationBitmapTests.cpp"
+#include "ReceiverBankTests.cpp"
+#include "ReferenceChannelTests.cpp"
+#include "SlotExecutorTests.cpp"
+#include "HeadlessSimulationTests.cpp"
 
 using namespace std;
 
@@ -39,6 +52,19 @@ int main(int argc, const char* argv[]) {
 	runner.addTest(L2HeaderTests::suite());
 	runner.addTest(L2PacketTests::suite());
 	runner.addTest(RngProviderTests::suite());
+	runner.addTest(L2HeaderCodecTests::suite());
+	runner.addTest(SlotArenaTests::suite());
+	runner.addTest(NeighborPositionTableTests::suite());
+	runner.addTest(SpatialGridTests::suite());
+	runner.addTest(PerSlotStatisticsTests::suite());
+	runner.addTest(StatisticTests::suite());
+	runner.addTest(DistributionStatisticTests::suite());
+	runner.addTest(IOmnetSinkTests::suite());
+	runner.addTest(SlotReservationBitmapTests::suite());
+	runner.addTest(ReceiverBankTests::suite());
+	runner.addTest(ReferenceChannelTests::suite());
+	runner.addTest(SlotExecutorTests::suite());
+	runner.addTest(HeadlessSimulationTests::suite());
 
 //    runner.run(result);
 	runner.run();